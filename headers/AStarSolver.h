@@ -2,29 +2,43 @@
 #define ASTAR_SOLVER_H
 
 #include "AStarState.h"
+#include "IHeuristic.h"
 #include "LatenessHeuristic.h"
 #include "StateGenerator.h"
 #include "ParsedBuffers.h"
+#include "NodeArena.h"
+#include "StateTable.h"
+#include "StateEncoding.h"
+#include "StateRanking.h"
+#include "SharedStacks.h"
+#include "OpenList.h"
+#include "HeuristicTelemetry.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <queue>
+#include <string>
 #include <unordered_map>
-#include <unordered_set>
 #include <chrono>
-
-struct AStarNode;
-
-struct NodeComparator {
-    bool operator()(const std::shared_ptr<AStarNode>& a, 
-                   const std::shared_ptr<AStarNode>& b) const;
-};
+#include <functional>
 
 struct AStarNode {
-    AStarState state;
-    double g;      double h;      double f;      std::shared_ptr<AStarNode> parent;      
-    AStarNode(const AStarState& s, double gCost, double hCost, 
-              std::shared_ptr<AStarNode> p = nullptr)
-        : state(s), g(gCost), h(hCost), f(gCost + hCost), parent(p) {}
+    SharedState state;      // stacks shared with the parent through the solver's StackCellPool
+    int g;      // accumulated lateness
+    int h;      // lower bound on the remaining lateness
+    int f;      uint32_t parent;      // arena index, NodeArena::NONE for the root
+    uint32_t liveChildren;      // children still referencing this node as parent
+    int expandedBound;      // partial expansion: successors with f bound up to here exist, INT_MIN if none
+    LatenessHeuristic::Terms heuristicTerms;      // per-stack terms of h, sequential search with LatenessHeuristic only
+    AStarNode(const SharedState& s, int gCost, int hCost, 
+              uint32_t p = NodeArena<AStarNode>::NONE)
+        : state(s), g(gCost), h(hCost), f(gCost + hCost), parent(p), liveChildren(0),
+          expandedBound(INT_MIN) {}
+
+    // Open-list priority: f, ties broken towards the earlier clock
+    uint64_t key() const { return packSearchKey(f, state.current_time); }
 };
 
 struct AStarSolution {
@@ -34,44 +48,117 @@ struct AStarSolution {
     int nodesExpanded;
     int nodesGenerated;
     double searchElapsedTime;      
+    double suboptimalityBound;      // proven ratio of the path's lateness to the optimum
     AStarSolution() : found(false), totalCost(0), nodesExpanded(0), 
-                     nodesGenerated(0), searchElapsedTime(0) {}
+                     nodesGenerated(0), searchElapsedTime(0), suboptimalityBound(1.0) {}
 };
 
 struct CompleteSolution {
     std::vector<AStarState> path;
     double totalCost;
     double totalLateness;
+    int finishTime;
+    double suboptimalityBound;      // proven ratio to the optimal lateness, 1 when optimal
     int nodesExpandedWhenFound;
     std::vector<std::string> keyMoves;  };
 
+enum class SearchMode {
+    SEQUENTIAL,      // classic single-threaded A*, can collect several solutions
+    PARALLEL_HDA,    // hash-distributed A* over worker threads, best solution only
+    IDA_STAR,        // iterative deepening on f with a bounded transposition table
+    ANYTIME_ARA,     // weighted A* repaired with falling weights, publishes every improvement
+    FOCAL            // bounded-suboptimal A*_eps, expands f <= (1+eps)*f_min
+};
+
+using SolutionCallback = std::function<void(const CompleteSolution&)>;
+
 class AStarSolver {
 private:
-    std::unique_ptr<LatenessHeuristic> heuristic;
+    std::unique_ptr<IHeuristic> heuristic;      // LatenessHeuristic unless replaced
     std::unique_ptr<StateGenerator> generator;
     
         int maxNodes;      bool verbose;      int maxSolutionsToFind;      int initialContainerCount;
+    SearchMode searchMode;
+    int threadCount;      // PARALLEL_HDA workers, 0 = hardware concurrency
+    size_t memoryBudgetBytes;      // IDA_STAR transposition table budget, 0 = unbounded
+    size_t nodeBudgetBytes;      // sequential mode: full nodes up to maxNodes must fit, else delta nodes; 0 = unbounded
+    int snapshotInterval;      // delta nodes: plies between stored states
+    double anytimeInitialWeight;
+    double anytimeWeightStep;
+    double anytimeTimeLimit;      // seconds, counted once a plan is found; 0 = run until the weight reaches 1
+    SolutionCallback solutionCallback;
+    double focalEpsilon;
+    bool verifyFingerprints;
+    size_t denseStateLimit;     // sequential mode: rank configurations when there are at most this many, 0 = never
+    int bufferSize;
+    bool partialExpansion;      // sequential mode: build only successors whose f bound is due (PEA*)
+    OpenListType openListType;
+    std::string heuristicReportFile;
     
         mutable int nodesExpanded;
     mutable int nodesGenerated;
     mutable int duplicatesDetected;
+    mutable int partialReexpansions;
+    mutable int fingerprintCollisions;
     mutable double searchElapsedTime;      
+    mutable size_t peakNodeBytes;      // sequential search: nodes plus their stack cells
+    mutable long peakResidentKb;
+    mutable HeuristicTelemetry telemetry;
         std::vector<CompleteSolution> allSolutions;
+
+    // Every node of the current search; released in bulk when solve() returns
+    NodeArena<AStarNode> nodes;
+    // Stack cells of the nodes' states
+    StackCellPool stackCells;
+
+    // Best g, closed flag and node index per visited state fingerprint
+    StateTable stateTable;
+    // Packed configuration keys for the state table in verification mode
+    std::unique_ptr<StateEncoding> stateEncoding;
+    // Perfect configuration ranks for the state table on small yards
+    std::unique_ptr<StateRanking> stateRanking;
+
+    // Upper bound on the state table pre-sizing derived from maxNodes
+    static constexpr size_t MAX_PRESIZED_STATES = size_t(1) << 18;
+
+public:
+    // 32 MB of state table entries
+    static constexpr size_t DEFAULT_DENSE_STATE_LIMIT = size_t(1) << 20;
+    static constexpr int DEFAULT_SNAPSHOT_INTERVAL = 8;
+
+private:
     
-    double calculateSimpleCost(const AStarState& state, 
-                              std::shared_ptr<AStarNode> parentNode) const;
-    int calculateMoveCount(const AStarState& state, 
-                          std::shared_ptr<AStarNode> parentNode) const;
+    int calculateSimpleCost(const AStarState& state, uint32_t parentNode) const;
+    int evaluateHeuristic(const AStarState& state) const;
+    int calculateMoveCount(const AStarState& state, uint32_t parentNode) const;
     int calculateIdlePeriods(const AStarState& state) const;
-    void debugSimpleCost(const AStarState& state, 
-                        std::shared_ptr<AStarNode> parentNode) const;
+    void debugSimpleCost(const AStarState& state, uint32_t parentNode) const;
 
-        std::vector<AStarState> reconstructPath(std::shared_ptr<AStarNode> goalNode) const;
-    void printSearchProgress(int expanded, int queueSize, double bestF) const;
+        std::vector<AStarState> reconstructPath(uint32_t goalNode) const;
+    CompleteSolution makeCompleteSolution(std::vector<AStarState> path, int g) const;
+    // Records a solution and hands it to the solution callback
+    void publishSolution(const CompleteSolution& completeSol);
+    // Lowers the bound of the last published solution and hands it to the callback again
+    void tightenPublishedBound(double bound);
+    // Sorts allSolutions, writes BestSolutionMoves.txt and fills in the result
+    AStarSolution finishSearch(std::chrono::high_resolution_clock::time_point startTime);
+
+    AStarSolution solveParallel(const AStarState& initialState);
+    AStarSolution solveIterativeDeepening(const AStarState& initialState);
+    AStarSolution solveAnytime(const AStarState& initialState);
+    AStarSolution solveFocal(const AStarState& initialState);
+    AStarSolution solveDeltaNodes(const AStarState& initialState);
+    // Sequential search with maxNodes full nodes would not fit the node budget
+    bool needsDeltaNodes() const;
+    // Recycles a finished node with no live children, then any ancestors left childless
+    void releaseNode(uint32_t index);
+    void printSearchProgress(int expanded, int queueSize, int bestF) const;
     
 public:
         explicit AStarSolver(const ParsedBuffers& buffers, int maxNodes = 100000, 
-                        bool verbose = false, int maxSolutions = 10);
+                        bool verbose = false, int maxSolutions = 10,
+                        bool useHugePages = false,
+                        SearchMode mode = SearchMode::SEQUENTIAL, int threads = 0);
     
         AStarSolution solve(const AStarState& initialState);
     
@@ -83,9 +170,43 @@ public:
     int getNodesExpanded() const { return nodesExpanded; }
     int getNodesGenerated() const { return nodesGenerated; }
     int getDuplicatesDetected() const { return duplicatesDetected; }
+    int getPartialReexpansions() const { return partialReexpansions; }
+    int getFingerprintCollisions() const { return fingerprintCollisions; }
+    size_t getPeakNodeBytes() const { return peakNodeBytes; }
+    const StateTable& getStateTable() const { return stateTable; }
+    const HeuristicTelemetry& getHeuristicTelemetry() const { return telemetry; }
+    // JSON report of heuristic quality for the last search
+    void writeHeuristicReport(std::ostream& out) const;
+    // printStatistics() also writes the report to this file; empty (the default) for none
+    void setHeuristicReportFile(const std::string& path) { heuristicReportFile = path; }
     
         void setVerbose(bool v) { verbose = v; }
+    void setVerifyFingerprints(bool v) { verifyFingerprints = v; }
+    void setDenseStateLimit(size_t states) { denseStateLimit = states; }
+    // True when the last search keyed its state table by configuration rank
+    bool usedDenseStates() const { return stateRanking != nullptr; }
+    void setPartialExpansion(bool v) { partialExpansion = v; }
+    // One operator per relocation (pick-up and put-down together), halving the plan depth
+    void setMacroActions(bool v) { generator->setMacroActions(v); }
+    void setOpenListType(OpenListType type) { openListType = type; }
+    void setSearchMode(SearchMode mode, int threads = 0) { searchMode = mode; threadCount = threads; }
+    void setMemoryBudget(size_t bytes) { memoryBudgetBytes = bytes; }
+    // Sequential search keeps delta nodes (solveDeltaNodes) once maxNodes full nodes exceed it
+    void setNodeBudget(size_t bytes) { nodeBudgetBytes = bytes; }
+    void setSnapshotInterval(int plies) { snapshotInterval = std::max(plies, 1); }
+    void setAnytimeSchedule(double initialWeight, double weightStep, double timeLimitSeconds = 0) {
+        anytimeInitialWeight = initialWeight;
+        anytimeWeightStep = weightStep;
+        anytimeTimeLimit = timeLimitSeconds;
+    }
+    void setFocalEpsilon(double epsilon) { focalEpsilon = epsilon; }
+    // Called with every solution as soon as it is found, and again when
+    // ANYTIME_ARA tightens the bound of the last one
+    void setSolutionCallback(SolutionCallback callback) { solutionCallback = std::move(callback); }
     void setMaxNodes(int max) { maxNodes = max; }
+    // Must stay admissible for the optimal modes
+    void setHeuristic(std::unique_ptr<IHeuristic> h) { heuristic = std::move(h); }
+    const IHeuristic& getHeuristic() const { return *heuristic; }
 };
 
 #endif 
\ No newline at end of file
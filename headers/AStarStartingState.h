@@ -5,6 +5,8 @@
 #include "ParsedBuffers.h"
 #include "SingleContainerCrane.h"
 
+// Both reset the ContainerTable: states built from an earlier call must not
+// be used afterwards
 AStarState makeAStarInitialState(ParsedBuffers& parsedBuffers);
 
 AStarState makeAStarCurrentState(ParsedBuffers& parsedBuffers, int currentSystemTime, SingleContainerCrane* crane);
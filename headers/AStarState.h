@@ -1,84 +1,192 @@
 #ifndef ASTAR_STATE_H
 #define ASTAR_STATE_H
 
+#include <cstdint>
 #include <optional>
 #include <vector>
 #include <string>
 #include <iostream>
-#include "UntilDueContainer.h"
+#include <type_traits>
+#include "ContainerTable.h"
+
+// One stack of a state, read-only. Containers come out as ContainerView
+// values, so loops written for vector<UntilDueContainer> still work.
+class StackView {
+public:
+    class iterator {
+    public:
+        iterator(const StackView* stack, size_t pos) : stack(stack), pos(pos) {}
+        ContainerView operator*() const { return (*stack)[pos]; }
+        iterator& operator++() { pos++; return *this; }
+        bool operator!=(const iterator& other) const { return pos != other.pos; }
+    private:
+        const StackView* stack;
+        size_t pos;
+    };
+
+    StackView(const ContainerIndex* slots, size_t count, int exitBottomTime, bool isExit)
+        : slots(slots), count(count), exitBottomTime(exitBottomTime), isExit(isExit) {}
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    ContainerView operator[](size_t pos) const;
+    ContainerView back() const { return (*this)[count - 1]; }
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, count); }
+
+private:
+    const ContainerIndex* slots;
+    size_t count;
+    int exitBottomTime;
+    bool isExit;
+};
+
+// All stacks of a state in one fixed-size block: container indices packed
+// stack after stack, with the end offset of each stack. The last stack is
+// the exit stack, whose containers clear one EXIT_INTERVAL apart from the
+// bottom one's exit time down to the top.
+class StackArray {
+public:
+    static constexpr int MAX_STACKS = 8;
+    static constexpr int MAX_CONTAINERS = 64;
+    static constexpr int EXIT_INTERVAL = 60;
+
+    class iterator {
+    public:
+        iterator(const StackArray* stacks, size_t index) : stacks(stacks), index(index) {}
+        StackView operator*() const { return (*stacks)[index]; }
+        iterator& operator++() { index++; return *this; }
+        bool operator!=(const iterator& other) const { return index != other.index; }
+    private:
+        const StackArray* stacks;
+        size_t index;
+    };
+
+    size_t size() const { return stackCount; }
+    StackView operator[](size_t s) const {
+        int start = s == 0 ? 0 : ends[s - 1];
+        return StackView(slots + start, ends[s] - start, exitBottomTime, s + 1 == stackCount);
+    }
+    StackView back() const { return (*this)[stackCount - 1]; }
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, stackCount); }
+
+    void addStack();
+    void push(int stackIndex, ContainerIndex container);
+    ContainerIndex pop(int stackIndex);
+
+    // Puts a container on the exit stack clearing at exitTime; the ones
+    // below it move to clear EXIT_INTERVAL apart after it
+    void pushToExit(ContainerIndex container, int exitTime);
+
+private:
+    friend class StackCellPool;
+
+    uint8_t stackCount = 0;
+    uint8_t ends[MAX_STACKS] = {};
+    int32_t exitBottomTime = 0;
+    ContainerIndex slots[MAX_CONTAINERS];
+};
+
+inline ContainerView StackView::operator[](size_t pos) const {
+    return ContainerView(slots[pos], isExit ? exitBottomTime - static_cast<int>(pos) * StackArray::EXIT_INTERVAL : -1);
+}
 
 struct CraneState {
     int position;
     bool hasContainer;
-    std::string containerId;
+    ContainerIndex heldContainer;   // NO_CONTAINER when empty
 
-        std::optional<UntilDueContainer> heldContainer;
-
-        CraneState() : position(0), hasContainer(false), containerId(""), heldContainer(std::nullopt) {}
+        CraneState() : position(0), hasContainer(false), heldContainer(NO_CONTAINER) {}
 
         std::string toString() const {
         std::string result = "Crane at stack " + std::to_string(position);
         if (hasContainer) {
-            result += " holding " + (containerId.empty() ? "???" : containerId);
+            result += " holding " + (heldContainer == NO_CONTAINER ? "???" : ContainerTable::get(heldContainer).id);
         } else {
             result += " (empty)";
         }
         return result;
     }
 
-        const UntilDueContainer* getHeldContainer() const {
-        return hasContainer && heldContainer.has_value() ? &heldContainer.value() : nullptr;
+        std::optional<ContainerView> getHeldContainer() const {
+        if (hasContainer && heldContainer != NO_CONTAINER) {
+            return ContainerView(heldContainer);
+        }
+        return std::nullopt;
     }
 };
 
-struct AStarState {
-                    std::vector<std::vector<UntilDueContainer>> stacks;
-    
-        int current_time;
-    
+// The move that produced a state, kept as indices and spelled out on output.
+// A relocation prints as its pick-up and put-down joined by ";;", the
+// separator of BestSolutionMoves.txt.
+struct LastAction {
+    enum Kind : uint8_t { INITIAL, PICK_UP, PUT_DOWN, RELOCATE, WAIT };
+    Kind kind = INITIAL;
+    int8_t fromStack = -1;
+    int8_t toStack = -1;
+    bool toExit = false;
+    ContainerIndex container = NO_CONTAINER;
+    int waitTime = 0;
+
+    std::string toString() const;
+};
+
+std::ostream& operator<<(std::ostream& out, const LastAction& action);
+
+// Everything in a state but its stacks, so stored nodes can keep the
+// stacks in another form (SharedState)
+struct StateHeader {
+        int current_time = 0;
+
         CraneState crane;
-    
-        std::string lastAction;
-    double accumulatedCost;
-
-    int consecutiveWaits;
-    int totalWaitTime;
-    int nextClearingTime;  
-    
-        struct ClearedContainer {
-        std::string id;
-        int clearedAtTime;
-        int lateness;
-    };
-    std::vector<ClearedContainer> clearedContainers;
-    double totalAccumulatedLateness;      
-        AStarState() : current_time(0), accumulatedCost(0), 
-                   consecutiveWaits(0), totalWaitTime(0), 
-                   totalAccumulatedLateness(0),
-                   lastAction("Initial state") {}
-    
+
+        LastAction lastAction;
+    double accumulatedCost = 0;
+
+    int consecutiveWaits = 0;
+    int totalWaitTime = 0;
+    double totalAccumulatedLateness = 0;
+
+    // Zobrist fingerprint of the configuration (same fields as getStateHash()),
+    // kept up to date incrementally by StateGenerator
+    uint64_t fingerprint = 0;
+};
+
+struct AStarState : StateHeader {
+                    StackArray stacks;
+
         std::string getStateHash() const;
-    
+
+    // Full recomputation of the fingerprint from scratch
+    uint64_t computeFingerprint() const;
+
+    // True when both states have the configuration that getStateHash() and
+    // the fingerprint describe (crane, held container, unexited containers)
+    bool sameConfiguration(const AStarState& other) const;
+
         bool isGoalState() const;
-    
+
         void printState() const;
-    
+
         int getTotalContainers() const;
-    
+
         int getUnexitedContainers() const;
-    
+
             std::pair<int, int> findContainer(const std::string& containerId) const;
-    
+
         bool canPickUpFrom(int stackIndex) const;
     bool canPutDownOn(int stackIndex, int bufferSize) const;
-    
+
         double getTotalLateness() const;
     void setTotalLateness(int late);
-    
-        UntilDueContainer* getTopContainer(int stackIndex);
-    const UntilDueContainer* getTopContainer(int stackIndex) const;
-    
+
+        std::optional<ContainerView> getTopContainer(int stackIndex) const;
+
         bool operator==(const AStarState& other) const;
 };
 
-#endif 
\ No newline at end of file
+// Successors are copied from their parent, which is a plain memcpy
+static_assert(std::is_trivially_copyable<AStarState>::value, "AStarState must stay trivially copyable");
+
+#endif
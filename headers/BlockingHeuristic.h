@@ -0,0 +1,42 @@
+#ifndef BLOCKING_HEURISTIC_H
+#define BLOCKING_HEURISTIC_H
+
+#include "ExitSlotHeuristic.h"
+#include "IHeuristic.h"
+#include "LatenessHeuristic.h"
+#include "ParsedBuffers.h"
+#include <string>
+
+// Blocking-aware lower bound in the style of the LB1/LB3 relocation bounds.
+//
+// Take the k containers that are due first, S. Before the last of them
+// leaves, every container of S and every container stacked above one of
+// them has to be put down at least once, either on the outgoing stack or
+// as a relocation, and the crane does these put-downs one at a time, with
+// a full exit cycle between two exits of S. That gives a finishing time
+// for S which, together with the exit slots of S
+// (see ExitSlotHeuristic), bounds the lateness of S. The other containers
+// are bounded one by one. The result is the best such bound over all k,
+// and never below LatenessHeuristic.
+class BlockingHeuristic : public IHeuristic {
+public:
+    explicit BlockingHeuristic(const ParsedBuffers& buffers);
+
+    double evaluate(const AStarState& state) const override;
+    std::string getName() const override { return "Blocking Heuristic"; }
+    bool coversLateness() const override { return true; }
+
+private:
+    using Item = ExitSlotHeuristic::Release;
+
+    LatenessHeuristic base;
+    int craneMoveTime;
+    int craneLowerTime;
+    int craneLiftTime;
+    int exitCycleTime;      // between two put-downs on the outgoing stack
+    int putDownGap;      // between any two put-downs
+
+    double blockingLateness(const AStarState& state) const;
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef CONTAINER_TABLE_H
+#define CONTAINER_TABLE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+using ContainerIndex = uint16_t;
+constexpr ContainerIndex NO_CONTAINER = 0xFFFF;
+
+// Immutable per-container data shared by every search state.
+// A container is interned once when a plan starts and from then on states
+// refer to it by a 16-bit index. Entries are never moved while a plan is
+// in use, so lookups need no lock; only intern() and reset() are
+// serialised. makeAStarCurrentState() resets the table, so it only ever
+// holds the yard being planned.
+class ContainerTable {
+public:
+    struct Entry {
+        int arrivalTime;
+        int dueIn;
+        uint64_t zobristKey;
+        std::string id;
+    };
+
+    // Index of the container with this id and these times, adding it when new
+    static ContainerIndex intern(const std::string& id, int arrivalTime, int dueIn);
+
+    static const Entry& get(ContainerIndex index) {
+        return chunks[index >> CHUNK_BITS][index & (CHUNK_SIZE - 1)];
+    }
+
+    static size_t size();
+
+    // Forgets every container. Indices handed out before are invalid
+    // afterwards, so no state of an earlier plan may still be in use.
+    static void reset();
+
+private:
+    static constexpr int CHUNK_BITS = 8;
+    static constexpr int CHUNK_SIZE = 1 << CHUNK_BITS;
+    static constexpr int CHUNK_COUNT = (NO_CONTAINER >> CHUNK_BITS) + 1;
+
+    static std::unique_ptr<Entry[]> chunks[CHUNK_COUNT];
+};
+
+// A container as seen from a state: its table entry plus the exit time,
+// which the state knows for containers on the exit stack (-1 elsewhere)
+class ContainerView {
+public:
+    ContainerView(ContainerIndex index, int exitTime = -1) : index(index), exitTime(exitTime) {}
+
+    ContainerIndex getIndex() const { return index; }
+    const std::string& getId() const { return ContainerTable::get(index).id; }
+    int getArrivalTime() const { return ContainerTable::get(index).arrivalTime; }
+    int getDueIn() const { return ContainerTable::get(index).dueIn; }
+    int getDueTime() const { return getArrivalTime() + getDueIn(); }
+    int getExitTime() const { return exitTime; }
+
+private:
+    ContainerIndex index;
+    int exitTime;
+};
+
+#endif
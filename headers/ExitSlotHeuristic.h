@@ -0,0 +1,64 @@
+#ifndef EXIT_SLOT_HEURISTIC_H
+#define EXIT_SLOT_HEURISTIC_H
+
+#include "IHeuristic.h"
+#include "LatenessHeuristic.h"
+#include "ParsedBuffers.h"
+#include <string>
+#include <vector>
+
+// Lower bound from the outgoing stack's throughput.
+//
+// Every remaining container has to be lowered onto the outgoing stack, and
+// two such put-downs are at least one crane round trip apart: lift, move
+// away, pick a container, move back, lower. With r_i the earliest time
+// container i could reach the outgoing stack on its own, the k-th exit of
+// any schedule is no earlier than
+//
+//     e_1 = r_(1),  e_k = max(e_(k-1) + cycle, r_(k))
+//
+// over the release times in increasing order. Matching these slots to the
+// due times in increasing order minimises the lateness of the relaxation,
+// which is therefore a lower bound in O(n log n). The result is max'ed with
+// LatenessHeuristic.
+class ExitSlotHeuristic : public IHeuristic {
+public:
+    explicit ExitSlotHeuristic(const ParsedBuffers& buffers);
+
+    double evaluate(const AStarState& state) const override;
+    std::string getName() const override { return "Exit Slot Heuristic"; }
+    bool coversLateness() const override { return true; }
+
+    // Shortest time between two put-downs on the outgoing stack
+    int getExitCycleTime() const { return exitCycleTime; }
+
+    // A remaining container and the earliest time it could be lowered onto
+    // the outgoing stack on its own
+    struct Release {
+        int stack;      // -1 for the held container
+        int height;
+        int release;
+        int dueTime;
+    };
+
+    // Release of every remaining container: the held one first, then stack
+    // by stack from the bottom. Also used by BlockingHeuristic and
+    // LearnedHeuristic, so the three agree on r_i.
+    static std::vector<Release> releaseTimes(const AStarState& state, int craneMoveTime,
+                                             int craneLowerTime, int craneLiftTime);
+
+    // Lateness of the exit slots over `releases` matched in order to
+    // `dues`; sorts both
+    static double matchedSlotLateness(std::vector<int>& releases, std::vector<int>& dues, int exitCycleTime);
+
+private:
+    LatenessHeuristic base;
+    int craneMoveTime;
+    int craneLowerTime;
+    int craneLiftTime;
+    int exitCycleTime;
+
+    double slotLateness(const AStarState& state) const;
+};
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef HEURISTIC_REGISTRY_H
+#define HEURISTIC_REGISTRY_H
+
+#include "IHeuristic.h"
+#include "ParsedBuffers.h"
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Heuristics by name, for choosing one at run time.
+//
+// A specification is one registered name, or several joined with commas,
+// which builds a MaxHeuristic over them in the given order:
+//
+//     lateness
+//     lateness,exit-slot,blocking
+class HeuristicRegistry {
+public:
+    using Factory = std::function<std::unique_ptr<IHeuristic>(const ParsedBuffers&)>;
+
+    // The registry with every built-in heuristic
+    static HeuristicRegistry& instance();
+
+    void add(const std::string& name, const std::string& description, Factory factory);
+    bool contains(const std::string& name) const;
+
+    // Throws std::invalid_argument for an unknown name
+    std::unique_ptr<IHeuristic> create(const std::string& specification, const ParsedBuffers& buffers) const;
+
+    void printAvailable(std::ostream& out) const;
+
+private:
+    struct Registration {
+        std::string name;
+        std::string description;
+        Factory factory;
+    };
+
+    std::vector<Registration> registrations;
+
+    HeuristicRegistry();
+    const Registration* find(const std::string& name) const;
+};
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef HEURISTIC_TELEMETRY_H
+#define HEURISTIC_TELEMETRY_H
+
+#include "AStarState.h"
+#include "IHeuristic.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// How tight and how costly the heuristic was in one search.
+//
+// Evaluations are counted exactly. Their time is measured on every
+// SAMPLE_INTERVAL-th call and extrapolated, which keeps the clock out of
+// the hot path. Counters are atomic so the parallel workers can share them;
+// recordExpansion() is for the sequential search only.
+class HeuristicTelemetry {
+public:
+    static constexpr uint64_t SAMPLE_INTERVAL = 64;
+
+    struct PathPoint {
+        int step;
+        int g;
+        int h;
+        int costToGo;      // lateness still to come on the solution path
+    };
+
+    HeuristicTelemetry() { reset(); }
+
+    void reset();
+
+    // Runs fn, which evaluates `evaluations` states, and accounts for it
+    template <typename Fn>
+    auto measure(uint64_t evaluations, Fn&& fn) {
+        uint64_t call = calls.fetch_add(1, std::memory_order_relaxed);
+        this->evaluations.fetch_add(evaluations, std::memory_order_relaxed);
+        if (call % SAMPLE_INTERVAL != 0) {
+            return fn();
+        }
+        auto start = std::chrono::steady_clock::now();
+        auto result = fn();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        timedEvaluations.fetch_add(evaluations, std::memory_order_relaxed);
+        timedNanoseconds.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                                   std::memory_order_relaxed);
+        return result;
+    }
+
+    // One expansion at this f; expansions sharing an f form a plateau
+    void recordExpansion(int f) { expansionsPerF[f]++; }
+
+    // Compares h with the realised cost-to-go at every state of the plan
+    void recordSolutionPath(const std::vector<AStarState>& path, const IHeuristic& heuristic);
+
+    uint64_t getEvaluations() const { return evaluations.load(std::memory_order_relaxed); }
+    double getEvaluateSeconds() const;
+    const std::vector<PathPoint>& getSolutionPath() const { return solutionPath; }
+
+    void printSummary(std::ostream& out) const;
+    // JSON object with the counters, plateau distribution and path samples
+    void writeReport(std::ostream& out, const std::string& heuristicName, const std::string& searchMode) const;
+
+private:
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> evaluations;
+    std::atomic<uint64_t> timedEvaluations;
+    std::atomic<uint64_t> timedNanoseconds;
+    std::unordered_map<int, uint64_t> expansionsPerF;      // sorted by f only when reported
+    std::vector<PathPoint> solutionPath;
+
+    // Plateau sizes bucketed by powers of two: bucket i holds sizes in [2^i, 2^(i+1))
+    std::vector<uint64_t> plateauHistogram() const;
+};
+
+#endif
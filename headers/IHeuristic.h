@@ -2,6 +2,7 @@
 #define IHEURISTIC_H
 
 #include "AStarState.h"
+#include <cstddef>
 #include <string>
 
 // Base interface for all heuristics
@@ -13,8 +14,24 @@ public:
     // Returns estimated cost from this state to goal
     virtual double evaluate(const AStarState& state) const = 0;
     
+    // Evaluate several states at once, e.g. all successors of one expansion;
+    // values[i] receives evaluate(*states[i])
+    virtual void evaluateBatch(const AStarState* const* states, size_t count, double* values) const {
+        for (size_t i = 0; i < count; i++) {
+            values[i] = evaluate(*states[i]);
+        }
+    }
+    
+    // True when no value is below LatenessHeuristic's for the same state;
+    // partial expansion bounds successors before they are evaluated and
+    // needs it
+    virtual bool coversLateness() const { return false; }
+    
     // Get name of the heuristic for debugging
     virtual std::string getName() const = 0;
+
+    // Heuristic-specific statistics for the end-of-search report
+    virtual void printStatistics() const {}
 };
 
 #endif // IHEURISTIC_H
\ No newline at end of file
@@ -3,7 +3,9 @@
 
 #include "IHeuristic.h"
 #include "ParsedBuffers.h"
+#include "StateGenerator.h"
 #include <string>
+#include <vector>
 
 class LatenessHeuristic : public IHeuristic {
 private:
@@ -15,15 +17,42 @@ private:
     int getMinMovesBetweenStacks(int from, int to) const;
     
 public:
+    // Incremental form of the bound. Once the crane's reach time T for a
+    // stack is known, a container there adds max(0, T - slack), where slack
+    // depends only on its due time and position. A node keeps every slack in
+    // one buffer: the first stackCount entries (exit stack excluded) plus one
+    // are where each stack's slacks start, followed by the slacks, ascending
+    // within a stack. A move recomputes only the stack it touched and copies
+    // the rest from the parent.
+    using Terms = std::vector<int>;
+
         explicit LatenessHeuristic(const ParsedBuffers& buffers);
     
         double evaluate(const AStarState& state) const override;
+
+    // Gathers the ready times and slacks of every container of the batch
+    // into flat arrays and sums max(0, ready - slack) with AVX2 or SSE2 when
+    // the build targets them, scalar code otherwise
+    void evaluateBatch(const AStarState* const* states, size_t count, double* values) const override;
+
+    // Same value as evaluate(), also filling in the per-stack terms
+    double evaluate(const AStarState& state, Terms& terms) const;
+
+    // Value for a successor reached with `action`, rebuilding only the
+    // stacks the action changed
+    double evaluateIncremental(const AStarState& child, const Action& action,
+                               const Terms& parentTerms, Terms& childTerms) const;
     std::string getName() const override { return "Lateness Heuristic"; }
+    bool coversLateness() const override { return true; }
     
         int getCraneMoveTime() const { return craneMoveTime; }
     int getCraneLowerTime() const { return craneLowerTime; }
     int getCraneLiftTime() const { return craneLiftTime; }
     int getClearingTime() const { return clearingTime; }
+
+private:
+    void appendStackSlacks(const AStarState& state, int stackIndex, Terms& terms) const;
+    double sumTerms(const AStarState& state, const Terms& terms) const;
 };
 
 #endif 
\ No newline at end of file
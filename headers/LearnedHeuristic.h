@@ -0,0 +1,109 @@
+#ifndef LEARNED_HEURISTIC_H
+#define LEARNED_HEURISTIC_H
+
+#include "ExitSlotHeuristic.h"
+#include "IHeuristic.h"
+#include "LearnedHeuristicModel.h"
+#include "ParsedBuffers.h"
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+
+// Cost-to-go estimate from a linear model over yard features, trained
+// offline by trainLearnedHeuristic.cpp on optimally solved small yards.
+//
+// The estimate is NOT admissible: it is meant for yards too large for
+// optimal search, where a quicker, possibly suboptimal plan is preferred.
+// Inference is header-only; the weights live in LearnedHeuristicModel.h,
+// which the training tool regenerates.
+class LearnedHeuristic : public IHeuristic {
+public:
+    static constexpr int FEATURE_COUNT = LearnedHeuristicModel::FEATURE_COUNT;
+    using Features = std::array<double, FEATURE_COUNT>;
+
+    explicit LearnedHeuristic(const ParsedBuffers& buffers) {
+        UntilDue move = buffers.getCraneMove();
+        UntilDue lower = buffers.getCraneLower();
+        UntilDue lift = buffers.getCraneLift();
+        craneMoveTime = move.getMinutes() * 60 + move.getSeconds();
+        craneLowerTime = lower.getMinutes() * 60 + lower.getSeconds();
+        craneLiftTime = lift.getMinutes() * 60 + lift.getSeconds();
+        exitCycleTime = 2 * (craneLowerTime + craneLiftTime + craneMoveTime);
+        std::copy(std::begin(LearnedHeuristicModel::WEIGHTS), std::end(LearnedHeuristicModel::WEIGHTS),
+                  weights.begin());
+    }
+
+    double evaluate(const AStarState& state) const override {
+        Features features = computeFeatures(state);
+        double estimate = 0.0;
+        for (int i = 0; i < FEATURE_COUNT; i++) {
+            estimate += weights[i] * features[i];
+        }
+        return std::max(0.0, estimate);
+    }
+
+    std::string getName() const override { return "Learned Heuristic"; }
+
+    void setWeights(const Features& w) { weights = w; }
+
+    // Every feature is in seconds, or a count scaled by the exit cycle
+    //   0 bias
+    //   1 sum of each container's lateness if it had the crane to itself
+    //   2 lateness of the exit slots matched to due times (ExitSlotHeuristic)
+    //   3 remaining containers
+    //   4 containers stacked above one that is due earlier
+    //   5 sum of how long the overdue containers are already overdue
+    //   6 overdue containers
+    //   7 crane holding a container
+    Features computeFeatures(const AStarState& state) const {
+        int now = state.current_time;
+        auto held = state.crane.getHeldContainer();
+
+        std::vector<int> releases;
+        std::vector<int> dues;
+        Features features{};
+        features[0] = 1.0;
+        int overdue = 0;
+        int blocking = 0;
+        int stack = -1;
+        int earliestBelow = 0;
+        for (const auto& container :
+             ExitSlotHeuristic::releaseTimes(state, craneMoveTime, craneLowerTime, craneLiftTime)) {
+            features[1] += std::max(0, container.release - container.dueTime);
+            if (container.dueTime < now) {
+                features[5] += now - container.dueTime;
+                overdue++;
+            }
+            if (container.stack != stack) {
+                stack = container.stack;
+                earliestBelow = 0;
+            }
+            if (container.stack >= 0) {
+                if (container.height > 0 && container.dueTime > earliestBelow) {
+                    blocking++;
+                }
+                earliestBelow = container.height == 0 ? container.dueTime
+                                                      : std::min(earliestBelow, container.dueTime);
+            }
+            releases.push_back(container.release);
+            dues.push_back(container.dueTime);
+        }
+        features[2] = ExitSlotHeuristic::matchedSlotLateness(releases, dues, exitCycleTime);
+
+        features[3] = static_cast<double>(releases.size()) * exitCycleTime;
+        features[4] = static_cast<double>(blocking) * exitCycleTime;
+        features[6] = static_cast<double>(overdue) * exitCycleTime;
+        features[7] = held ? exitCycleTime : 0.0;
+        return features;
+    }
+
+private:
+    int craneMoveTime;
+    int craneLowerTime;
+    int craneLiftTime;
+    int exitCycleTime;
+    Features weights;
+};
+
+#endif
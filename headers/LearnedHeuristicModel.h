@@ -0,0 +1,11 @@
+#ifndef LEARNED_HEURISTIC_MODEL_H
+#define LEARNED_HEURISTIC_MODEL_H
+
+// Generated by trainLearnedHeuristic.cpp - do not edit by hand.
+// 300 yards of 7 containers (seed 1), 5650 states, mean absolute error 101.8 s.
+namespace LearnedHeuristicModel {
+constexpr int FEATURE_COUNT = 8;
+constexpr double WEIGHTS[FEATURE_COUNT] = {-80.8191913, 1.6979146, 4.82640585, 1.00057229, 0.792099195, -5.02221505, -4.49947135, 0.805735016};
+}
+
+#endif
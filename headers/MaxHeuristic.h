@@ -0,0 +1,52 @@
+#ifndef MAX_HEURISTIC_H
+#define MAX_HEURISTIC_H
+
+#include "IHeuristic.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Maximum over several admissible heuristics, itself admissible.
+//
+// Every evaluation credits the component that supplied the maximum; on a
+// tie the earlier component gets it, so cheap components should be listed
+// first. Once a component has been evaluated minEvaluations times and
+// supplied less than minWinShare of the maxima, it is switched off for the
+// rest of the run. The first component is never switched off. Statistics
+// are atomic, so one instance can serve the parallel search.
+class MaxHeuristic : public IHeuristic {
+public:
+    explicit MaxHeuristic(std::vector<std::unique_ptr<IHeuristic>> components);
+
+    double evaluate(const AStarState& state) const override;
+    std::string getName() const override;
+    // The first component is never switched off
+    bool coversLateness() const override { return !components.empty() && components[0]->coversLateness(); }
+    void printStatistics() const override;
+
+    void setDropPolicy(uint64_t minEvaluations, double minWinShare) {
+        dropAfter = minEvaluations;
+        dropShare = minWinShare;
+    }
+
+    size_t getComponentCount() const { return components.size(); }
+    bool isActive(size_t component) const { return stats[component].active.load(std::memory_order_relaxed); }
+
+private:
+    struct ComponentStats {
+        std::atomic<uint64_t> evaluations{0};
+        std::atomic<uint64_t> wins{0};
+        std::atomic<bool> active{true};
+    };
+
+    std::vector<std::unique_ptr<IHeuristic>> components;
+    std::unique_ptr<ComponentStats[]> stats;
+    uint64_t dropAfter;
+    double dropShare;
+
+    void reviewComponent(size_t component, uint64_t evaluations) const;
+};
+
+#endif
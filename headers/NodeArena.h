@@ -0,0 +1,134 @@
+#ifndef NODE_ARENA_H
+#define NODE_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+// Chunked arena for search nodes addressed by 32-bit indices.
+// Nodes never move once created, so indices (and references) stay valid
+// until the node is recycled or clear() destroys every node in bulk.
+// Recycled slots go on a free list and are handed out again by emplace().
+template <typename T>
+class NodeArena {
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    explicit NodeArena(bool useHugePages = false, size_t chunkShift = 14)
+        : hugePages(useHugePages), shift(chunkShift), mask((size_t(1) << chunkShift) - 1),
+          count(0), peakCount(0) {}
+
+    ~NodeArena() { release(); }
+
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    template <typename... Args>
+    uint32_t emplace(Args&&... args) {
+        uint32_t index;
+        if (!freeSlots.empty()) {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            if ((count >> shift) == chunks.size()) {
+                chunks.push_back(allocateChunk());
+            }
+            index = static_cast<uint32_t>(count);
+            count++;
+        }
+        new (&(*this)[index]) T(std::forward<Args>(args)...);
+        if (liveCount() > peakCount) {
+            peakCount = liveCount();
+        }
+        return index;
+    }
+
+    // Destroys one node; its slot is reused by a later emplace()
+    void recycle(uint32_t index) {
+        (*this)[index].~T();
+        freeSlots.push_back(index);
+    }
+
+    T& operator[](uint32_t index) { return chunks[index >> shift][index & mask]; }
+    const T& operator[](uint32_t index) const { return chunks[index >> shift][index & mask]; }
+
+    size_t size() const { return count; }
+    size_t liveCount() const { return count - freeSlots.size(); }
+    size_t peakSize() const { return peakCount; }
+    size_t bytesReserved() const { return chunks.size() * chunkBytes(); }
+    bool usesHugePages() const { return hugePages; }
+
+    // Destroys all nodes but keeps the chunks for the next search
+    void clear() {
+        std::vector<bool> isFree(count, false);
+        for (uint32_t index : freeSlots) {
+            isFree[index] = true;
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (!isFree[i]) {
+                chunks[i >> shift][i & mask].~T();
+            }
+        }
+        freeSlots.clear();
+        count = 0;
+        peakCount = 0;
+    }
+
+    // Destroys all nodes and hands the chunks back to the system
+    void release() {
+        clear();
+        for (T* chunk : chunks) {
+            freeChunk(chunk);
+        }
+        chunks.clear();
+    }
+
+private:
+    bool hugePages;
+    size_t shift;
+    size_t mask;
+    size_t count;
+    size_t peakCount;
+    std::vector<T*> chunks;
+    std::vector<uint32_t> freeSlots;
+
+    size_t chunkBytes() const { return (size_t(1) << shift) * sizeof(T); }
+
+    T* allocateChunk() {
+#ifdef __linux__
+        if (hugePages) {
+            void* p = mmap(nullptr, chunkBytes(), PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            madvise(p, chunkBytes(), MADV_HUGEPAGE);
+            return static_cast<T*>(p);
+        }
+#endif
+        void* p = std::malloc(chunkBytes());
+        if (!p) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(p);
+    }
+
+    void freeChunk(T* chunk) {
+#ifdef __linux__
+        if (hugePages) {
+            munmap(chunk, chunkBytes());
+            return;
+        }
+#endif
+        std::free(chunk);
+    }
+};
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef OPEN_LIST_H
+#define OPEN_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Open-list priority: lateness-based f first, then the state's clock.
+// Both are whole seconds, so they pack into one 64-bit key whose integer
+// order is exactly the lexicographic (f, time) order.
+inline uint64_t packSearchKey(int f, int time) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(f)) << 32) | static_cast<uint32_t>(time);
+}
+
+inline int searchKeyF(uint64_t key) { return static_cast<int>(key >> 32); }
+inline int searchKeyTime(uint64_t key) { return static_cast<int>(key & 0xffffffffULL); }
+
+enum class OpenListType { RADIX_HEAP, DARY_HEAP };
+
+// Base interface for open lists holding node indices under a packed key
+class IOpenList {
+public:
+    virtual ~IOpenList() = default;
+
+    virtual void push(uint64_t key, uint32_t node) = 0;
+
+    // Removes and returns the node with the smallest key
+    virtual uint32_t pop() = 0;
+
+    virtual uint64_t topKey() = 0;
+    virtual bool empty() const = 0;
+    virtual size_t size() const = 0;
+    virtual void clear() = 0;
+
+    virtual std::string getName() const = 0;
+};
+
+// 4-ary min-heap over (key, node) pairs stored contiguously
+class DaryHeapOpenList : public IOpenList {
+public:
+    void push(uint64_t key, uint32_t node) override;
+    uint32_t pop() override;
+    uint64_t topKey() override { return heap.front().first; }
+    bool empty() const override { return heap.empty(); }
+    size_t size() const override { return heap.size(); }
+    void clear() override { heap.clear(); }
+    std::string getName() const override { return "4-ary heap"; }
+
+private:
+    static constexpr size_t ARITY = 4;
+    std::vector<std::pair<uint64_t, uint32_t>> heap;
+};
+
+// Radix heap: bucket i holds keys whose highest bit differing from the last
+// popped key is bit i-1, so every item is redistributed at most 64 times.
+// The heuristic is not guaranteed to be consistent, so a key below the last
+// popped one can still arrive; those go to a small heap that is always
+// drained first, since all of its keys are smaller than any bucketed key.
+class RadixHeapOpenList : public IOpenList {
+public:
+    RadixHeapOpenList();
+
+    void push(uint64_t key, uint32_t node) override;
+    uint32_t pop() override;
+    uint64_t topKey() override;
+    bool empty() const override { return count == 0; }
+    size_t size() const override { return count; }
+    void clear() override;
+    std::string getName() const override { return "radix heap"; }
+
+    size_t getNonMonotonePushes() const { return nonMonotonePushes; }
+
+private:
+    static constexpr int BUCKETS = 65;
+
+    std::vector<std::pair<uint64_t, uint32_t>> buckets[BUCKETS];
+    DaryHeapOpenList belowLast;
+    uint64_t last;
+    size_t count;
+    size_t nonMonotonePushes;
+
+    static int bucketFor(uint64_t key, uint64_t last);
+    void refill();
+};
+
+std::unique_ptr<IOpenList> makeOpenList(OpenListType type);
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef PATTERN_DATABASE_HEURISTIC_H
+#define PATTERN_DATABASE_HEURISTIC_H
+
+#include "IHeuristic.h"
+#include "LatenessHeuristic.h"
+#include "ParsedBuffers.h"
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Additive pattern-database heuristic over pairs of containers.
+//
+// A pattern is one or two stored containers together with the crane, the
+// number of other containers stacked above each of them and whether one
+// sits on the other. For every such configuration the database holds the
+// exit-time offsets of all schedules that are optimal for some pair of due
+// times (a Pareto set), found by an exact search under the real crane
+// times. The offsets do not depend on due times, so one table serves every
+// instance with the same crane times and buffer size.
+//
+// Lateness is a sum over containers, so the pattern bounds of a partition
+// of the containers add up. Containers are paired in due order, and the
+// result is never below LatenessHeuristic.
+//
+// Configurations are solved on first use and written to a cache file named
+// after the yard parameters, which later runs load at start-up.
+class PatternDatabaseHeuristic : public IHeuristic {
+public:
+    explicit PatternDatabaseHeuristic(const ParsedBuffers& buffers, const std::string& cacheDirectory = ".");
+    ~PatternDatabaseHeuristic() override;
+
+    double evaluate(const AStarState& state) const override;
+    std::string getName() const override { return "Pattern Database Heuristic"; }
+    bool coversLateness() const override { return true; }
+
+    // Writes every solved configuration to the cache file
+    bool save() const;
+
+    size_t getPatternCount() const;
+    const std::string& getCachePath() const { return cachePath; }
+
+private:
+    // Exit offsets (first, second) of the non-dominated schedules; a single
+    // container pattern leaves the second offset at 0
+    using OffsetSet = std::vector<std::pair<int, int>>;
+
+    struct PatternItem {
+        int stack;      // HELD when on the crane
+        int height;
+        int dueTime;
+    };
+
+    static constexpr int HELD = 14;
+    static constexpr int EXITED = 15;
+
+    LatenessHeuristic base;
+    int craneMoveTime;
+    int craneLowerTime;
+    int craneLiftTime;
+    int bufferSize;
+    std::string cachePath;
+
+    mutable std::mutex tableMutex;
+    mutable std::unordered_map<uint64_t, OffsetSet> table;
+    mutable bool dirty;
+
+    uint64_t encodePattern(const AStarState& state, const PatternItem* items, int count) const;
+    const OffsetSet& lookup(uint64_t config) const;
+    OffsetSet solvePattern(uint64_t config) const;
+    bool load();
+};
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef RANDOM_YARD_H
+#define RANDOM_YARD_H
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Random yards in the input file format for the root-level tools
+// (trainLearnedHeuristic, stateEncodingReport, searchRegressionCheck):
+// entry stack, three buffer stacks and the outgoing stack, with due times
+// between 0:30 and 8:00.
+namespace RandomYard {
+
+// Buffer size, clearing time, crane timings and stack names
+constexpr const char* HEADER =
+    "<BUFFER SIZE>10</BUFFER SIZE>\n<CLEARING TIME>1:00</CLEARING TIME>\n"
+    "<CRANE LIFT>0:2</CRANE LIFT>\n<CRANE MOVE>0:10</CRANE MOVE>\n<CRANE LOWER>0:2</CRANE LOWER>\n"
+    "A0|B0|B1|B2|H0\n";
+
+// Container rows that follow HEADER, bottom row first
+inline std::string generateRows(int containers, std::mt19937& rng) {
+    std::uniform_int_distribution<int> stackOf(0, 3);
+    std::uniform_int_distribution<int> dueOf(30, 480);
+    std::vector<std::vector<std::string>> stacks(4);
+    for (int i = 0; i < containers; i++) {
+        int due = dueOf(rng);
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "B%d(%d:%02d)", 100 + i, due / 60, due % 60);
+        stacks[stackOf(rng)].push_back(buffer);
+    }
+
+    size_t height = 0;
+    for (const auto& stack : stacks) {
+        height = std::max(height, stack.size());
+    }
+
+    std::string rows;
+    for (size_t row = 0; row < height; row++) {
+        for (const auto& stack : stacks) {
+            rows += (row < stack.size() ? stack[row] : "") + "|";
+        }
+        rows += "\n";
+    }
+    return rows;
+}
+
+inline void writeInstance(const std::string& path, const std::string& rows) {
+    std::ofstream(path) << HEADER << rows;
+}
+
+inline void writeInstance(const std::string& path, int containers, std::mt19937& rng) {
+    writeInstance(path, generateRows(containers, rng));
+}
+
+}
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef SHARED_STACKS_H
+#define SHARED_STACKS_H
+
+#include "AStarState.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Stacks of a stored search node: the top cell of each stack in a
+// StackCellPool. Cells are immutable and point at the cell below, so a
+// child shares every stack its move left alone, and the unchanged bottom
+// of the others, with its parent.
+struct SharedStacks {
+    static constexpr uint32_t EMPTY = UINT32_MAX;
+
+    uint32_t tops[StackArray::MAX_STACKS];
+    uint8_t heights[StackArray::MAX_STACKS];
+    uint8_t stackCount;
+    int32_t exitBottomTime;
+};
+
+// A search node's state with its stacks held in a StackCellPool
+struct SharedState : StateHeader {
+    SharedStacks stacks;
+};
+
+// Per-search pool of reference-counted stack cells. A cell is counted once
+// per stored state whose top it is and once per cell resting on it; it is
+// freed when the count drops to zero and reused by a later push.
+class StackCellPool {
+public:
+    // Stores a state with no parent to share with
+    SharedState store(const AStarState& state);
+    // Stores a successor of parent, whose stored form is parentShared
+    SharedState share(const AStarState& state, const AStarState& parent, const SharedState& parentShared);
+    AStarState restore(const SharedState& shared) const;
+    // Drops a stored state's references
+    void release(const SharedState& shared);
+    void clear();
+
+    size_t liveCells() const { return cells.size() - freeCells.size(); }
+    size_t peakCells() const { return peak; }
+    size_t peakBytes() const { return peak * sizeof(Cell); }
+
+private:
+    struct Cell {
+        uint32_t below;
+        uint32_t refs;
+        ContainerIndex container;
+    };
+
+    std::vector<Cell> cells;
+    std::vector<uint32_t> freeCells;
+    size_t peak = 0;
+
+    uint32_t push(uint32_t below, ContainerIndex container);
+    void retain(uint32_t cell) {
+        if (cell != SharedStacks::EMPTY) {
+            cells[cell].refs++;
+        }
+    }
+    void drop(uint32_t cell);
+    SharedState build(const AStarState& state, const AStarState* parent, const SharedState* parentShared);
+};
+
+#endif
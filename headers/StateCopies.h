@@ -0,0 +1,70 @@
+#ifndef STATE_COPIES_H
+#define STATE_COPIES_H
+
+#include "AStarState.h"
+#include "NodeArena.h"
+#include "Zobrist.h"
+#include <climits>
+#include <cstdint>
+
+// Duplicate detection for the searches that expand out of f order (focal
+// search, ARA*). One best g per configuration is not enough there: a copy
+// reached more cheaply can be later or blocked on the exit stack longer,
+// and dropping the other copy loses plans that f_min still has to cover.
+//
+// A state is keyed by its configuration and its uncleared exit stack, which
+// decides when the next exit put-down is allowed. Copies with the same key
+// are only dropped for one that is no worse on every count below; the rest
+// stay live side by side, chained through their nodes.
+namespace StateCopies {
+
+inline uint64_t key(const AStarState& state) {
+    uint64_t key = state.fingerprint;
+    int exitStack = static_cast<int>(state.stacks.size()) - 1;
+    auto exit = state.stacks[exitStack];
+    for (size_t height = 0; height < exit.size(); height++) {
+        key ^= ZobristKeys::placementKey(exit[height].getIndex(), exitStack, static_cast<int>(height));
+    }
+    return key;
+}
+
+// When the last uncleared exit container clears
+inline int exitClearTime(const AStarState& state) {
+    auto exit = state.stacks[state.stacks.size() - 1];
+    return exit.empty() ? INT_MIN : exit[0].getExitTime();
+}
+
+// Whatever the copy at (gB, b) can still do, the one at (gA, a) can do as
+// well by waiting first
+inline bool noWorseThan(int gA, const AStarState& a, int gB, const AStarState& b) {
+    return gA <= gB && a.current_time <= b.current_time && a.consecutiveWaits <= b.consecutiveWaits &&
+           exitClearTime(a) <= exitClearTime(b);
+}
+
+// Walks the live copies chained from head (Node has g, state, nextCopy and
+// superseded). Returns false when one of them is no worse than a new copy
+// at (g, state); otherwise unlinks and marks every copy the new one is no
+// worse than, passing each to onSuperseded, and the caller links the new
+// node in front of head.
+template <typename Node, typename OnSuperseded>
+bool admit(NodeArena<Node>& nodes, uint32_t& head, int g, const AStarState& state, OnSuperseded onSuperseded) {
+    uint32_t* link = &head;
+    while (*link != NodeArena<Node>::NONE) {
+        Node& copy = nodes[*link];
+        if (noWorseThan(copy.g, copy.state, g, state)) {
+            return false;
+        }
+        if (noWorseThan(g, state, copy.g, copy.state)) {
+            copy.superseded = true;
+            onSuperseded(copy);
+            *link = copy.nextCopy;
+            continue;
+        }
+        link = &copy.nextCopy;
+    }
+    return true;
+}
+
+}
+
+#endif
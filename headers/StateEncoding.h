@@ -0,0 +1,42 @@
+#ifndef STATE_ENCODING_H
+#define STATE_ENCODING_H
+
+#include "AStarState.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Canonical bit-packed encoding of a configuration: crane position, held
+// container and the unexited containers of every stack but the exit stack,
+// the same fields the fingerprint covers. Built per search from the initial
+// state, whose n containers get codes 1..n in ceil(log2(n+1)) bits; 0 ends a
+// stack. Two states encode equally exactly when sameConfiguration() holds.
+class StateEncoding {
+public:
+    explicit StateEncoding(const AStarState& initialState);
+
+    // 64-bit words per encoded state
+    size_t getWords() const { return words; }
+    size_t getBits() const { return bits; }
+    size_t getBytes() const { return words * sizeof(uint64_t); }
+    int getContainerCount() const { return static_cast<int>(containers.size()); }
+
+    // Writes getWords() words to out
+    void encode(const AStarState& state, uint64_t* out) const;
+
+    // Configuration only: time, lateness and the exit stack stay empty
+    AStarState decode(const uint64_t* in) const;
+
+private:
+    std::vector<ContainerIndex> containers;   // code - 1 -> container
+    std::vector<uint16_t> codes;              // container -> code
+    int stackCount;
+    int positionBits;
+    int slotBits;
+    size_t bits;
+    size_t words;
+
+    static int bitsFor(int maxValue);
+};
+
+#endif
@@ -7,44 +7,77 @@
 #include <memory>
 
 struct Action {
-    enum Type { PICK_UP, PUT_DOWN, WAIT };
+    enum Type { PICK_UP, PUT_DOWN, WAIT, RELOCATE };
     Type type;
     int targetStack;
     std::string description;
     int waitTime;      
-    Action(Type t, int stack, const std::string& desc, int wait = 0) 
-        : type(t), targetStack(stack), description(desc), waitTime(wait) {}
+    int sourceStack;    // RELOCATE only: the stack the container is taken from
+    Action(Type t, int stack, const std::string& desc, int wait = 0, int source = -1) 
+        : type(t), targetStack(stack), description(desc), waitTime(wait), sourceStack(source) {}
 };
 
 class StateGenerator {
 public:
     StateGenerator(const ParsedBuffers& buffers);
+
+    // Macro actions: an empty crane gets one successor per pick-up/put-down
+    // pair instead of a pick-up followed by a separate put-down node. The
+    // pick-up alone is kept as well when an uncleared exit top still blocks
+    // the held container, so the crane can wait for it to clear.
+    void setMacroActions(bool enabled) { macroActions = enabled; }
+    bool getMacroActions() const { return macroActions; }
     
-        std::vector<std::pair<AStarState, double>> generateSuccessors(const AStarState& current) const;
+        // actions, when given, receives the operator behind each successor
+        std::vector<std::pair<AStarState, double>> generateSuccessors(const AStarState& current,
+                                                                  std::vector<Action>* actions = nullptr) const;
     
         std::vector<Action> getValidActions(const AStarState& current) const;
 
+    // Partial expansion: materialises only the successors whose f lower
+    // bound lies in (minBound, maxBound]. nextBound receives the smallest
+    // bound above maxBound, or INT_MAX when every successor is out.
+    // bounds, when given, receives the bound of each materialised successor.
+    std::vector<std::pair<AStarState, double>> generateSuccessorsInBand(const AStarState& current, int g,
+                                                                        int minBound, int maxBound,
+                                                                        int& nextBound,
+                                                                        std::vector<int>* bounds = nullptr) const;
+
+    // Lower bound on g + LatenessHeuristic of the successor reached after
+    // `duration` seconds with the crane at cranePosition, so also on g + h
+    // for any heuristic that covers LatenessHeuristic. takenFrom / placedOn
+    // name the stack that loses or gains a container, -1 for none.
+    int successorLowerBound(const AStarState& current, int g, int duration, int cranePosition,
+                            bool holding, int takenFrom, int placedOn) const;
+
+    // Replays the move a successor recorded in its lastAction on the state
+    // it was generated from, giving the same successor back
+    AStarState applyAction(const AStarState& current, const LastAction& action) const;
+
 private:
     const ParsedBuffers& buffers;
     int craneMoveTime;
     int craneLowerTime;
     int craneLiftTime;
     int clearingTime;
+    bool macroActions = false;
     
         AStarState applyPickUp(const AStarState& current, int stackIndex, double& cost) const;
     AStarState applyPutDown(const AStarState& current, int stackIndex, double& cost) const;
     AStarState applyWait(const AStarState& current, int waitTime, double& cost) const;
     
-        void updateAllContainerTimes(AStarState& state, int elapsedTime) const;
-    int calculateCraneMoveTime(int from, int to) const;
+        int calculateCraneMoveTime(int from, int to) const;
     void clearExitedContainers(AStarState& state, int elapsedTime) const;
     
+    // The exit put-down is refused only until the exit stack's top clears
+    bool exitBlockedUntilCleared(const AStarState& holding) const;
         bool shouldConsiderWaiting(const AStarState& current) const;
     bool canWaitingHelp(const AStarState& current) const;
+    bool hasOverdueTop(const AStarState& current) const;
     bool hasWaitedTooMuch(const AStarState& current) const;
     int calculateOptimalWaitTime(const AStarState& current) const;
     
         static constexpr int MAX_CONSECUTIVE_WAITS = 6;
-    static constexpr double MAX_WAIT_RATIO = 1.0;      static constexpr int MAX_WAIT_TIME = 10;       };
+    static constexpr double MAX_WAIT_RATIO = 1.0;      };
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,49 @@
+#ifndef STATE_RANKING_H
+#define STATE_RANKING_H
+
+#include "AStarState.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Perfect ranking of the configurations reachable from an initial state
+// (crane position, held container and the unexited containers of every
+// stack but the exit stack) onto 0..getStateCount()-1. Nothing is ever put
+// down on the entry stack, so it is always a bottom part of its initial
+// contents; the buffer stacks hold any ordered selection of the remaining
+// containers up to the buffer size. Two states rank equally exactly when
+// sameConfiguration() holds.
+class StateRanking {
+public:
+    static constexpr uint64_t SATURATED = UINT64_MAX;
+
+    StateRanking(const AStarState& initialState, int bufferSize);
+
+    // Number of ranks, SATURATED when it does not fit in 64 bits
+    uint64_t getStateCount() const { return stateCount; }
+    int getContainerCount() const { return static_cast<int>(containers.size()); }
+
+    uint64_t rank(const AStarState& state) const;
+
+    // Configuration only: time, lateness and the exit stack stay empty
+    AStarState unrank(uint64_t rank) const;
+
+private:
+    std::vector<ContainerIndex> containers;   // code - 1 -> container, entry stack first from the bottom
+    std::vector<uint16_t> codes;              // container -> code
+    int stackCount;
+    int entryHeight;
+    std::vector<int> capacities;              // per buffer stack
+    // completions[(stack * (maxHeight + 1) + height) * (n + 1) + free]: ways
+    // to fill the buffer stacks from `stack` on, `height` containers already
+    // on it, with `free` containers left to place or leave exited
+    std::vector<uint64_t> completions;
+    int maxHeight;
+    std::vector<uint64_t> blockStart;         // first rank (per crane position) of each entry stack height
+    uint64_t stateCount;
+
+    uint64_t ways(int stack, int height, int free) const;
+    uint64_t block(int free) const;
+};
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef STATE_TABLE_H
+#define STATE_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Flat open-addressing table from state fingerprint to search bookkeeping.
+// Replaces the separate closed set and best-g map: one probe sequence per
+// successor finds the best g seen so far, the closed flag and the node index.
+class StateTable {
+public:
+    struct Entry {
+        uint64_t key;
+        uint64_t bestG;      // packSearchKey(g, time) of the best path found so far
+        uint32_t node;       // node that last improved bestG
+        bool occupied;
+        bool closed;
+    };
+
+    explicit StateTable(size_t expectedStates = 0);
+
+    // Exact keys: every entry also keeps its configuration's packed encoding
+    // (StateEncoding, `words` 64-bit words) and a lookup with an encoding
+    // matches only an equal one, so colliding fingerprints get their own
+    // entries. 0 turns it off. Clears the table.
+    void setEncodingWords(size_t words);
+    size_t getEncodingWords() const { return encodingWords; }
+
+    // Dense keys: keys are perfect ranks below `states` (StateRanking) and
+    // index the slots directly, with no hashing or probing. The table is
+    // allocated once at that size and never grows. 0 goes back to hashing.
+    // Clears the table.
+    void setDenseStates(size_t states);
+    size_t getDenseStates() const { return denseStates; }
+
+    // Sizes the table so that expectedStates fit without rehashing
+    void reserve(size_t expectedStates);
+    void clear();
+
+    // Returns nullptr when the key has not been seen
+    Entry* find(uint64_t key, const uint64_t* encoding = nullptr);
+
+    // Returns the entry for key, creating it (with bestG = UINT64_MAX) if needed.
+    // With exact keys, encoding must be given.
+    Entry& findOrInsert(uint64_t key, bool& inserted) { return findOrInsert(key, nullptr, inserted); }
+    Entry& findOrInsert(uint64_t key, const uint64_t* encoding, bool& inserted);
+
+    size_t size() const { return count; }
+    size_t capacity() const { return slots.size(); }
+    size_t bytesUsed() const {
+        return slots.size() * sizeof(Entry) + encodings.size() * sizeof(uint64_t);
+    }
+    double loadFactor() const { return slots.empty() ? 0.0 : static_cast<double>(count) / slots.size(); }
+
+    uint64_t getLookups() const { return lookups; }
+    uint64_t getProbes() const { return probes; }
+    size_t getMaxProbeLength() const { return maxProbeLength; }
+    // Lookups that met an entry with the same fingerprint but another encoding
+    uint64_t getKeyCollisions() const { return keyCollisions; }
+    double getAverageProbeLength() const { return lookups ? static_cast<double>(probes) / lookups : 0.0; }
+
+    void printStatistics() const;
+
+private:
+    std::vector<Entry> slots;
+    std::vector<uint64_t> encodings;   // encodingWords per slot
+    size_t encodingWords;
+    size_t denseStates;
+    size_t count;
+    size_t mask;
+    int shift;
+
+    uint64_t lookups;
+    uint64_t probes;
+    size_t maxProbeLength;
+    uint64_t keyCollisions;
+
+    static constexpr double MAX_LOAD = 0.7;
+
+    size_t home(uint64_t key) const { return (key * 0x9e3779b97f4a7c15ULL) >> shift; }
+    void allocate(size_t slotCount);
+    void grow();
+    size_t probe(uint64_t key, const uint64_t* encoding, bool& found);
+    bool sameEncoding(size_t slot, const uint64_t* encoding) const;
+};
+
+#endif
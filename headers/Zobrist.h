@@ -0,0 +1,27 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include "ContainerTable.h"
+#include <cstdint>
+#include <string>
+
+// Zobrist keys for 64-bit state fingerprints.
+// A configuration's fingerprint is the XOR of one key per unexited container
+// (container, stack, height), one key for the held container and one key for
+// the crane position, so a move only has to XOR out/in the pieces it touches.
+class ZobristKeys {
+public:
+    static uint64_t containerKey(const std::string& containerId);
+    static uint64_t placementKey(const std::string& containerId, int stackIndex, int height);
+    static uint64_t heldKey(const std::string& containerId);
+    // Same keys for an interned container, without hashing the id again
+    static uint64_t placementKey(ContainerIndex container, int stackIndex, int height);
+    static uint64_t heldKey(ContainerIndex container);
+    static uint64_t craneKey(int position);
+
+private:
+    static uint64_t mix(uint64_t x);
+    static uint64_t slotKey(uint64_t containerKey, int stackIndex, int height);
+};
+
+#endif
@@ -12,6 +12,9 @@
 #include "AStarState.h"
 #include "AStarSolver.h"
 #include "AStarStartingState.h"
+#include "HeuristicRegistry.h"
+
+static constexpr int DEFAULT_MAX_NODES = 1000000000;
 
 // Forward declarations of printing functions
 void printAllSolutions(const AStarSolver& solver) {
@@ -55,11 +58,50 @@ void printDetailedSolution(const CompleteSolution& solution, int solutionNumber,
 int main(int argc, char* argv[]) {
 
     if (argc < 2) {
-        std::cout << "Usage: " << argv[0] << " <config_file> [verbose]" << std::endl;
+        std::cout << "Usage: " << argv[0] << " <config_file> [verbose] [--macro] [--heuristic <name>[,<name>...]] [--dense-limit <states>] [--max-nodes <n>] [--node-budget <MB>] [--heuristic-report <file>]" << std::endl;
+        std::cout << "       " << argv[0] << " --list-heuristics" << std::endl;
+        std::cout << "A yard may have at most " << StackArray::MAX_STACKS << " stacks and "
+                  << StackArray::MAX_CONTAINERS << " containers on the entry and buffer stacks;"
+                  << " larger yards are rejected with an error." << std::endl;
+        std::cout << "Nodes are delta-encoded when --max-nodes full nodes (default " << DEFAULT_MAX_NODES
+                  << ") would not fit in --node-budget." << std::endl;
         return 1;
     }
 
-    bool verbose = (argc > 2 && std::string(argv[2]) == "verbose");
+    if (std::string(argv[1]) == "--list-heuristics") {
+        std::cout << "Available heuristics (several names separated by commas take their maximum):" << std::endl;
+        HeuristicRegistry::instance().printAvailable(std::cout);
+        return 0;
+    }
+
+    bool verbose = false;
+    bool macroActions = false;
+    std::string heuristicSpec = "lateness";
+    size_t denseStateLimit = AStarSolver::DEFAULT_DENSE_STATE_LIMIT;
+    int maxNodes = DEFAULT_MAX_NODES;
+    size_t nodeBudget = 0;
+    std::string heuristicReport;
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "verbose") {
+            verbose = true;
+        } else if (arg == "--macro") {
+            macroActions = true;
+        } else if (arg == "--heuristic" && i + 1 < argc) {
+            heuristicSpec = argv[++i];
+        } else if (arg == "--dense-limit" && i + 1 < argc) {
+            denseStateLimit = std::stoull(argv[++i]);
+        } else if (arg == "--max-nodes" && i + 1 < argc) {
+            maxNodes = std::stoi(argv[++i]);
+        } else if (arg == "--node-budget" && i + 1 < argc) {
+            nodeBudget = std::stoull(argv[++i]) * 1024 * 1024;
+        } else if (arg == "--heuristic-report" && i + 1 < argc) {
+            heuristicReport = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return 1;
+        }
+    }
 
     // Open file for saving results
     std::ofstream MyFile("AStarProcess.txt");
@@ -78,7 +120,13 @@ int main(int argc, char* argv[]) {
         AStarState initialState = makeAStarInitialState(buffers);
 
         // Create solver that finds up to 10 solutions
-        AStarSolver solver(buffers, 1000000000, verbose, 10);
+        AStarSolver solver(buffers, maxNodes, verbose, 10);
+        solver.setHeuristic(HeuristicRegistry::instance().create(heuristicSpec, buffers));
+        solver.setMacroActions(macroActions);
+        solver.setDenseStateLimit(denseStateLimit);
+        solver.setNodeBudget(nodeBudget);
+        solver.setHeuristicReportFile(heuristicReport);
+        std::cout << "Heuristic: " << heuristicSpec << std::endl;
 
         std::cout << "\nRunning A* search for multiple solutions..." << std::endl;
         
@@ -0,0 +1,258 @@
+// Regression check for the search options.
+//
+// Runs every check below on generated yards and on the yards that exposed
+// earlier bugs, and fails when one of them does not hold:
+//  - partial expansion defers a successor under a lower bound on its f and
+//    must surface it no later than its f. Every bound the band generator
+//    gives on random walks through the yard, with and without macro
+//    actions, is compared with the successor's g + LatenessHeuristic.
+//  - focal search with eps must return a plan within (1+eps) times the
+//    lateness solve() finds.
+//  - every bound ARA* publishes must hold against solve()'s lateness, and
+//    the result it returns must be its last plan with its last bound.
+//  - HDA* with one worker must return the lateness solve() returns.
+//
+// Yards where solve() hits the node limit have no reference plan and only
+// run the checks that do not need one (the HDA* check compares with
+// whatever solve() returns). So do yards where LatenessHeuristic
+// overestimates somewhere along the reference plan: it can while the crane
+// holds a container, and then no f bound proves anything about that plan.
+//
+// Build:  g++ -std=c++17 -O2 searchRegressionCheck.cpp -L./build -lSimulator -Iheaders/ -lpthread
+// Run:    ./a.out [generated yards] [containers] [max nodes per search] [seed]
+
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AStarSolver.h"
+#include "AStarStartingState.h"
+#include "LatenessHeuristic.h"
+#include "ParsedBuffers.h"
+#include "RandomYard.h"
+#include "StateGenerator.h"
+
+namespace {
+
+constexpr int WALKS = 20;
+constexpr int WALK_LENGTH = 40;
+const std::vector<double> FOCAL_EPSILONS = {0.0, 0.2, 0.5};
+constexpr int ANYTIME_SOLUTIONS = 100;
+
+// Yards that returned worse plans before a fix
+const std::vector<std::pair<std::string, std::string>> KNOWN_YARDS = {
+    {"partial expansion with a held container",
+     "B100(7:33)||B101(4:01)|B105(3:25)|\n"
+     "B102(0:32)||||\n"
+     "B103(8:00)||||\n"
+     "B104(0:51)||||\n"},
+    {"focal search and ARA* dropping a state reached more cheaply",
+     "|B100(4:37)|B101(1:44)||\n"
+     "|B102(0:46)|B104(6:34)||\n"
+     "|B103(2:36)|||\n"},
+};
+
+struct Yard {
+    ParsedBuffers& buffers;
+    int maxNodes;
+    // Lateness of the plan solve() finds, -1 when there is none to compare
+    // with (node limit hit or the heuristic overestimates along it)
+    int reference;
+};
+
+struct Check {
+    std::string name;
+    // Empty when the check holds, otherwise what went wrong
+    std::function<std::string(const Yard&, std::mt19937&)> run;
+};
+
+// Result of a search that stopped at the node limit without a plan
+constexpr int NODE_LIMIT = -2;
+
+// Lateness of the best plan found with the given options, -1 for none,
+// NODE_LIMIT when the search gave up first
+int solveLateness(const Yard& yard, const std::function<void(AStarSolver&)>& configure) {
+    AStarSolver solver(yard.buffers, yard.maxNodes, false, 1);
+    configure(solver);
+    if (!solver.solve(makeAStarInitialState(yard.buffers)).found) {
+        return solver.getNodesExpanded() >= yard.maxNodes ? NODE_LIMIT : -1;
+    }
+    return static_cast<int>(solver.getAllSolutions().front().totalLateness);
+}
+
+// Lateness of solve()'s plan, -1 when it hits the node limit or when
+// g + LatenessHeuristic exceeds that lateness somewhere along the plan
+int referenceLateness(const Yard& yard) {
+    AStarSolver solver(yard.buffers, yard.maxNodes, false, 1);
+    if (!solver.solve(makeAStarInitialState(yard.buffers)).found) {
+        return -1;
+    }
+    const CompleteSolution& plan = solver.getAllSolutions().front();
+    int lateness = static_cast<int>(plan.totalLateness);
+    LatenessHeuristic heuristic(yard.buffers);
+    for (const auto& state : plan.path) {
+        if (state.getTotalLateness() + std::floor(heuristic.evaluate(state)) > lateness) {
+            return -1;
+        }
+    }
+    return lateness;
+}
+
+std::string checkBandBounds(const Yard& yard, std::mt19937& rng) {
+    ParsedBuffers& buffers = yard.buffers;
+    LatenessHeuristic heuristic(buffers);
+    for (bool macros : {false, true}) {
+        StateGenerator generator(buffers);
+        generator.setMacroActions(macros);
+        for (int walk = 0; walk < WALKS; walk++) {
+            AStarState state = makeAStarInitialState(buffers);
+            for (int step = 0; step < WALK_LENGTH && !state.isGoalState(); step++) {
+                int g = static_cast<int>(state.getTotalLateness());
+                int nextBound;
+                std::vector<int> bounds;
+                auto successors = generator.generateSuccessorsInBand(state, g, INT_MIN, INT_MAX, nextBound, &bounds);
+                if (successors.empty()) {
+                    break;
+                }
+                for (size_t i = 0; i < successors.size(); i++) {
+                    const AStarState& next = successors[i].first;
+                    int f = static_cast<int>(next.getTotalLateness()) +
+                            static_cast<int>(std::floor(heuristic.evaluate(next)));
+                    if (bounds[i] > f) {
+                        return "bound " + std::to_string(bounds[i]) + " above f " + std::to_string(f) +
+                               " after " + next.lastAction.toString();
+                    }
+                }
+                std::uniform_int_distribution<size_t> pick(0, successors.size() - 1);
+                state = successors[pick(rng)].first;
+            }
+        }
+    }
+    return "";
+}
+
+std::string checkAnytime(const Yard& yard, std::mt19937&) {
+    if (yard.reference < 0) {
+        return "";
+    }
+    AStarSolver solver(yard.buffers, yard.maxNodes, false, ANYTIME_SOLUTIONS);
+    solver.setSearchMode(SearchMode::ANYTIME_ARA);
+    std::string problem;
+    CompleteSolution last;
+    solver.setSolutionCallback([&](const CompleteSolution& plan) {
+        if (problem.empty() && plan.totalLateness > plan.suboptimalityBound * yard.reference + 1e-9) {
+            problem = "published lateness " + std::to_string(static_cast<int>(plan.totalLateness)) +
+                      " with bound " + std::to_string(plan.suboptimalityBound) + ", solve() " +
+                      std::to_string(yard.reference);
+        }
+        last = plan;
+    });
+    if (!solver.solve(makeAStarInitialState(yard.buffers)).found) {
+        return "no plan";
+    }
+    const CompleteSolution& result = solver.getAllSolutions().front();
+    if (problem.empty() && (result.totalLateness != last.totalLateness ||
+                            result.suboptimalityBound != last.suboptimalityBound)) {
+        problem = "returned lateness " + std::to_string(static_cast<int>(result.totalLateness)) + " with bound " +
+                  std::to_string(result.suboptimalityBound) + ", last published " +
+                  std::to_string(static_cast<int>(last.totalLateness)) + " with bound " +
+                  std::to_string(last.suboptimalityBound);
+    }
+    return problem;
+}
+
+std::string checkFocal(const Yard& yard, std::mt19937&) {
+    if (yard.reference < 0) {
+        return "";
+    }
+    for (double epsilon : FOCAL_EPSILONS) {
+        int lateness = solveLateness(yard, [epsilon](AStarSolver& solver) {
+            solver.setSearchMode(SearchMode::FOCAL);
+            solver.setFocalEpsilon(epsilon);
+        });
+        // Copies reached at different times cost focal search more nodes
+        // than solve(), so it may run out where solve() did not
+        if (lateness == NODE_LIMIT) {
+            continue;
+        }
+        if (lateness < 0 || lateness > (1.0 + epsilon) * yard.reference) {
+            return "eps " + std::to_string(epsilon) + " gave lateness " + std::to_string(lateness) +
+                   ", solve() " + std::to_string(yard.reference);
+        }
+    }
+    return "";
+}
+
+std::string checkParallel(const Yard& yard, std::mt19937&) {
+    int expected = solveLateness(yard, [](AStarSolver&) {});
+    int lateness = solveLateness(yard, [](AStarSolver& solver) {
+        solver.setSearchMode(SearchMode::PARALLEL_HDA, 1);
+    });
+    if (lateness != expected) {
+        return "one worker gave lateness " + std::to_string(lateness) + ", solve() " + std::to_string(expected);
+    }
+    return "";
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int yards = argc > 1 ? std::stoi(argv[1]) : 200;
+    int containers = argc > 2 ? std::stoi(argv[2]) : 5;
+    int maxNodes = argc > 3 ? std::stoi(argv[3]) : 200000;
+    unsigned seed = argc > 4 ? static_cast<unsigned>(std::stoul(argv[4])) : 1;
+    const std::string instancePath = "regressionInstance.txt";
+
+    const std::vector<Check> checks = {
+        {"partial expansion bounds", checkBandBounds},
+        {"focal search", checkFocal},
+        {"anytime search", checkAnytime},
+        {"parallel search", checkParallel},
+    };
+
+    std::vector<std::pair<std::string, std::string>> cases = KNOWN_YARDS;
+    std::mt19937 rng(seed);
+    for (int i = 0; i < yards; i++) {
+        cases.push_back({"generated #" + std::to_string(i + 1), RandomYard::generateRows(containers, rng)});
+    }
+
+    std::streambuf* console = std::cout.rdbuf();
+    std::ofstream discard("/dev/null");
+    int failures = 0;
+    int unsolved = 0;
+
+    for (const auto& [name, rows] : cases) {
+        RandomYard::writeInstance(instancePath, rows);
+        std::cout.rdbuf(discard.rdbuf());
+        ParsedBuffers buffers(instancePath);
+        Yard yard{buffers, maxNodes, -1};
+        yard.reference = referenceLateness(yard);
+        if (yard.reference < 0) {
+            unsolved++;
+        }
+        std::vector<std::string> regressions;
+        for (const auto& check : checks) {
+            std::string problem = check.run(yard, rng);
+            if (!problem.empty()) {
+                regressions.push_back(check.name + ": " + problem);
+            }
+        }
+        std::cout.rdbuf(console);
+
+        for (const auto& regression : regressions) {
+            std::cerr << name << " - " << regression << std::endl << rows;
+            failures++;
+        }
+    }
+    std::remove(instancePath.c_str());
+
+    std::cout << cases.size() << " yards (" << unsolved << " without a reference plan), "
+              << failures << " regressions" << std::endl;
+    return failures > 0 ? 1 : 0;
+}
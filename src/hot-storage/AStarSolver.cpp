@@ -6,24 +6,52 @@
 #include <set>
 #include <thread>
 #include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <sys/resource.h>
 
 
-// NodeComparator implementation
-bool NodeComparator::operator()(const std::shared_ptr<AStarNode>& a, 
-                               const std::shared_ptr<AStarNode>& b) const {
-    // For min-heap, return true if a has higher f-value than b
-    return a->f > b->f;
-}
-
-AStarSolver::AStarSolver(const ParsedBuffers& buffers, int maxNodes, bool verbose, int maxSolutions) 
-    : maxNodes(maxNodes), verbose(verbose), maxSolutionsToFind(maxSolutions), nodesExpanded(0),
-      nodesGenerated(0), duplicatesDetected(0), searchElapsedTime(0.0) {
+AStarSolver::AStarSolver(const ParsedBuffers& buffers, int maxNodes, bool verbose, int maxSolutions,
+                         bool useHugePages, SearchMode mode, int threads) 
+    : maxNodes(maxNodes), verbose(verbose), maxSolutionsToFind(maxSolutions),
+      searchMode(mode), threadCount(threads), memoryBudgetBytes(0), nodeBudgetBytes(0), snapshotInterval(DEFAULT_SNAPSHOT_INTERVAL),
+      anytimeInitialWeight(3.0), anytimeWeightStep(0.5), anytimeTimeLimit(0.0), focalEpsilon(0.2),
+      verifyFingerprints(false), denseStateLimit(DEFAULT_DENSE_STATE_LIMIT), bufferSize(buffers.getBufferSize()),
+      partialExpansion(false), openListType(OpenListType::RADIX_HEAP),
+      nodesExpanded(0), nodesGenerated(0), duplicatesDetected(0), partialReexpansions(0),
+      fingerprintCollisions(0), searchElapsedTime(0.0), peakNodeBytes(0), peakResidentKb(0),
+      nodes(useHugePages) {
     
     heuristic = std::make_unique<LatenessHeuristic>(buffers);
     generator = std::make_unique<StateGenerator>(buffers);
 }
 
 AStarSolution AStarSolver::solve(const AStarState& initialState) {
+    partialReexpansions = 0;
+    telemetry.reset();
+
+    if (searchMode == SearchMode::PARALLEL_HDA && !initialState.isGoalState()) {
+        return solveParallel(initialState);
+    }
+    if (searchMode == SearchMode::IDA_STAR && !initialState.isGoalState()) {
+        return solveIterativeDeepening(initialState);
+    }
+    if (searchMode == SearchMode::ANYTIME_ARA && !initialState.isGoalState()) {
+        return solveAnytime(initialState);
+    }
+    if (searchMode == SearchMode::FOCAL && !initialState.isGoalState()) {
+        return solveFocal(initialState);
+    }
+    if (needsDeltaNodes() && !initialState.isGoalState()) {
+        return solveDeltaNodes(initialState);
+    }
+    // Band bounds are computed from LatenessHeuristic and would surface
+    // deferred successors too late under a smaller heuristic
+    if (partialExpansion && !heuristic->coversLateness()) {
+        throw std::invalid_argument("Partial expansion needs a heuristic no smaller than LatenessHeuristic, not " +
+                                    heuristic->getName());
+    }
+
     auto startTime = std::chrono::high_resolution_clock::now();
     initialContainerCount = initialState.getUnexitedContainers();
     AStarSolution solution;
@@ -31,6 +59,7 @@ AStarSolution AStarSolver::solve(const AStarState& initialState) {
     nodesExpanded = 0;
     nodesGenerated = 0;
     duplicatesDetected = 0;
+    fingerprintCollisions = 0;
     allSolutions.clear();  
     
     
@@ -41,26 +70,93 @@ AStarSolution AStarSolver::solve(const AStarState& initialState) {
         return solution;
     }
     
-    std::priority_queue<std::shared_ptr<AStarNode>, 
-                       std::vector<std::shared_ptr<AStarNode>>, 
-                       NodeComparator> openSet;
-    
-    // Closed set to track visited states
-    std::unordered_set<std::string> closedSet;
-    
-    // Also keep track of best g-values for each state
-    std::unordered_map<std::string, double> bestG;
+    std::unique_ptr<IOpenList> openSet = makeOpenList(openListType);
+    nodes.clear();
+    stackCells.clear();
+    
+    // Small yards are ranked perfectly: the rank is the state table key and
+    // indexes it directly, so there is no hashing and nothing to verify
+    stateRanking.reset();
+    if (denseStateLimit > 0) {
+        auto ranking = std::make_unique<StateRanking>(initialState, bufferSize);
+        if (ranking->getStateCount() <= denseStateLimit) {
+            stateRanking = std::move(ranking);
+        }
+    }
+    auto keyOf = [&](const AStarState& state) -> uint64_t {
+        if (!stateRanking) {
+            return state.fingerprint;
+        }
+        uint64_t rank = stateRanking->rank(state);
+        #ifdef DEBUG
+        if (rank >= stateRanking->getStateCount() || !stateRanking->unrank(rank).sameConfiguration(state)) {
+            std::cerr << "[ERROR] State rank does not round-trip after: " << state.lastAction << std::endl;
+            abort();
+        }
+        #endif
+        return rank;
+    };
+
+    // Otherwise verification also keys the table by each configuration's
+    // packed encoding, so states whose fingerprints collide are never merged
+    std::vector<uint64_t> encoded;
+    stateEncoding.reset();
+    if (verifyFingerprints && !stateRanking) {
+        stateEncoding = std::make_unique<StateEncoding>(initialState);
+        encoded.resize(stateEncoding->getWords());
+    }
+    auto encodingOf = [&](const AStarState& state) -> const uint64_t* {
+        if (!stateEncoding) {
+            return nullptr;
+        }
+        stateEncoding->encode(state, encoded.data());
+        #ifdef DEBUG
+        if (!stateEncoding->decode(encoded.data()).sameConfiguration(state)) {
+            std::cerr << "[ERROR] State encoding does not round-trip after: " << state.lastAction << std::endl;
+            abort();
+        }
+        #endif
+        return encoded.data();
+    };
+
+    // Closed flags and best g-values for each state, keyed by rank or Zobrist fingerprint
+    stateTable.setEncodingWords(encoded.size());
+    stateTable.setDenseStates(stateRanking ? stateRanking->getStateCount() : 0);
+    stateTable.clear();
+    stateTable.reserve(std::min(static_cast<size_t>(std::max(maxNodes, 0)), MAX_PRESIZED_STATES));
     
     bool foundFirstSolution = false;
-    double firstSolutionCost = std::numeric_limits<double>::max();
+
+    // The default heuristic is updated from the parent's per-stack terms
+    // instead of rescanning every stack; partial expansion bounds successors
+    // before they exist and keeps the full evaluation
+    const LatenessHeuristic* incremental =
+        partialExpansion ? nullptr : dynamic_cast<const LatenessHeuristic*>(heuristic.get());
+    LatenessHeuristic::Terms rootTerms;
+    std::vector<Action> actions;
+    std::vector<int> bandBounds;
+    // Otherwise every successor of an expansion is scored in one batch
+    std::vector<const AStarState*> batch;
+    std::vector<double> batchValues;
     
     // Create initial node
-    double g0 = initialState.getTotalLateness();   
-    double h0 = heuristic->evaluate(initialState); // estimated future lateness
+    int g0 = static_cast<int>(initialState.getTotalLateness());   
+    int h0 = incremental
+        ? telemetry.measure(1, [&] {
+              return static_cast<int>(std::floor(incremental->evaluate(initialState, rootTerms)));
+          })
+        : evaluateHeuristic(initialState); // estimated future lateness
 
-    auto startNode = std::make_shared<AStarNode>(initialState, g0, h0);
-    openSet.push(startNode);
-    bestG[initialState.getStateHash()] = g0;
+    AStarState root = initialState;
+    root.fingerprint = root.computeFingerprint();
+    uint32_t startIndex = nodes.emplace(stackCells.store(root), g0, h0);
+    AStarNode& startNode = nodes[startIndex];
+    startNode.heuristicTerms = std::move(rootTerms);
+    openSet->push(startNode.key(), startIndex);
+    bool inserted;
+    StateTable::Entry& startEntry = stateTable.findOrInsert(keyOf(root), encodingOf(root), inserted);
+    startEntry.bestG = packSearchKey(g0, initialState.current_time);
+    startEntry.node = startIndex;
     nodesGenerated++;
 
     
@@ -68,47 +164,40 @@ AStarSolution AStarSolver::solve(const AStarState& initialState) {
         std::cout << "\n=== A* Search Started ===" << std::endl;
         std::cout << "Initial heuristic value: " << h0 << std::endl;
         std::cout << "Max nodes limit: " << maxNodes << std::endl;
+        std::cout << "Open list: " << openSet->getName() << std::endl;
         std::cout << "Looking for up to " << maxSolutionsToFind << " solutions" << std::endl;
     }
     
     // Main A* loop
-    while (!openSet.empty() && nodesExpanded < maxNodes) {
-        auto current = openSet.top();
-        openSet.pop();
+    while (!openSet->empty() && nodesExpanded < maxNodes) {
+        int poppedF = searchKeyF(openSet->topKey());
+        uint32_t currentIndex = openSet->pop();
+        const AStarNode* current = &nodes[currentIndex];
+        const AStarState currentState = stackCells.restore(current->state);
+        bool reexpansion = current->expandedBound != INT_MIN;
+        if (reexpansion) {
+            // Drop the reference the queue entry held on the node
+            nodes[currentIndex].liveChildren--;
+        }
         
 
-        if (current->state.isGoalState()) {
-            CompleteSolution completeSol;
-            completeSol.path = reconstructPath(current);
-            completeSol.totalCost = current->g;
-            completeSol.totalLateness = current->state.getTotalLateness();
-            completeSol.nodesExpandedWhenFound = nodesExpanded;
-            
-            for (size_t i = 0; i < std::min(completeSol.path.size(), size_t(5)); i++) {
-                completeSol.keyMoves.push_back(completeSol.path[i].lastAction);
-            }
-            if (completeSol.path.size() > 7) {
-                completeSol.keyMoves.push_back("...");
-                for (size_t i = completeSol.path.size() - 2; i < completeSol.path.size(); i++) {
-                    completeSol.keyMoves.push_back(completeSol.path[i].lastAction);
-                }
-            }
-            
-            allSolutions.push_back(completeSol);
+        if (currentState.isGoalState()) {
+            CompleteSolution completeSol = makeCompleteSolution(reconstructPath(currentIndex), current->g);
+            publishSolution(completeSol);
+            releaseNode(currentIndex);
             
             if (!foundFirstSolution) {
                 foundFirstSolution = true;
-                firstSolutionCost = current->g;
                 
                 if (verbose) {
-                    std::cout << "\nFirst solution found! Cost: " << current->g 
+                    std::cout << "\nFirst solution found! Cost: " << completeSol.totalCost 
                               << ", Lateness: " << completeSol.totalLateness
                               << ". Continuing search for alternatives..." << std::endl;
                 }
             } else {
                 if (verbose) {
                     std::cout << "\nAlternative solution #" << allSolutions.size() 
-                              << " found! Cost: " << current->g 
+                              << " found! Cost: " << completeSol.totalCost 
                               << ", Lateness: " << completeSol.totalLateness << std::endl;
                 }
             }
@@ -123,39 +212,50 @@ AStarSolution AStarSolver::solve(const AStarState& initialState) {
             continue;
         }
         
-        std::string stateHash = current->state.getStateHash();
-        if (closedSet.count(stateHash) > 0) {
+        StateTable::Entry& currentEntry = stateTable.findOrInsert(keyOf(currentState), encodingOf(currentState), inserted);
+        if (currentEntry.closed && !reexpansion) {
             duplicatesDetected++;
+            if (nodes[currentIndex].liveChildren == 0) {
+                releaseNode(currentIndex);
+            }
             continue;
         }
+        currentEntry.closed = true;
         
-        nodesExpanded++;
-
-        closedSet.insert(stateHash);
+        if (reexpansion) {
+            partialReexpansions++;
+        } else {
+            nodesExpanded++;
+            telemetry.recordExpansion(current->f);
+        }
         
         if (verbose && nodesExpanded % 100 == 0) {
-            printSearchProgress(nodesExpanded, openSet.size(), current->f);
+            printSearchProgress(nodesExpanded, openSet->size(), current->f);
         }
 
-        auto successors = generator->generateSuccessors(current->state);
+        int nextBound = INT_MAX;
+        auto successors = partialExpansion
+            ? generator->generateSuccessorsInBand(currentState, current->g, current->expandedBound,
+                                                  poppedF, nextBound, &bandBounds)
+            : generator->generateSuccessors(currentState, incremental ? &actions : nullptr);
         
         if (verbose) {
             std::this_thread::sleep_for(std::chrono::milliseconds(400));
-            std::cout << "\n=== NODE " << nodesExpanded << " (" << current->state.lastAction 
+            std::cout << "\n=== NODE " << nodesExpanded << " (" << currentState.lastAction 
                       << ") f=" << current->f << " ===" << std::endl;
-            std::cout << "Time: " << current->state.current_time << "s | ";
+            std::cout << "Time: " << currentState.current_time << "s | ";
             std::cout << "Crane: ";
-            if (current->state.crane.hasContainer) {
-                std::cout << "holding " << current->state.crane.containerId << " at stack " << current->state.crane.position;
+            if (currentState.crane.hasContainer) {
+                std::cout << "holding " << currentState.crane.getHeldContainer()->getId() << " at stack " << currentState.crane.position;
             } else {
-                std::cout << "empty at stack " << current->state.crane.position;
+                std::cout << "empty at stack " << currentState.crane.position;
             }
             std::cout << std::endl;
             std::cout << "Stacks: ";
-            for (size_t i = 0; i < current->state.stacks.size(); i++) {
+            for (size_t i = 0; i < currentState.stacks.size(); i++) {
                 std::cout << "S" << i << "[";
-                for (size_t j = 0; j < current->state.stacks[i].size(); j++) {
-                    const auto& container = current->state.stacks[i][j];
+                for (size_t j = 0; j < currentState.stacks[i].size(); j++) {
+                    const auto& container = currentState.stacks[i][j];
                     std::cout << container.getId();
                     if (container.getExitTime() != -1) {
                         std::cout << "(exited)";
@@ -163,24 +263,35 @@ AStarSolution AStarSolver::solve(const AStarState& initialState) {
                         int dueTime = container.getArrivalTime() + container.getDueIn();
                         std::cout << "(due:" << dueTime << ")";
                     }
-                    if (j < current->state.stacks[i].size() - 1) std::cout << ",";
+                    if (j < currentState.stacks[i].size() - 1) std::cout << ",";
                 }
                 std::cout << "] ";
             }
             std::cout << std::endl;
         }
         
+        if (!incremental) {
+            batch.clear();
+            for (const auto& successor : successors) {
+                batch.push_back(&successor.first);
+            }
+            batchValues.resize(batch.size());
+            telemetry.measure(batch.size(), [&] {
+                heuristic->evaluateBatch(batch.data(), batch.size(), batchValues.data());
+                return 0;
+            });
+        }
+        
         int successorIndex = 0;
         for (const auto& [nextState, actionCost] : successors) {
             successorIndex++;
             
             // Set g to total lateness of the successor state (not accumulated cost)
-            double g = calculateSimpleCost(nextState, current);
-
-            std::string nextHash = nextState.getStateHash();
+            int g = calculateSimpleCost(nextState, currentIndex);
+            uint64_t gKey = packSearchKey(g, nextState.current_time);
 
-            auto it = bestG.find(nextHash);
-            if (it != bestG.end() && it->second <= g) {
+            StateTable::Entry* entry = &stateTable.findOrInsert(keyOf(nextState), encodingOf(nextState), inserted);
+            if (entry->bestG <= gKey) {
                 duplicatesDetected++;
                 if (verbose) {
                     std::cout << "  " << successorIndex << ". " << nextState.lastAction 
@@ -189,45 +300,136 @@ AStarSolution AStarSolver::solve(const AStarState& initialState) {
                 continue;
             }
 
-            bestG[nextHash] = g;
+            entry->bestG = gKey;
 
-            double h = heuristic->evaluate(nextState);
-            double f = g + h;
+            LatenessHeuristic::Terms childTerms;
+            int h = incremental
+                ? telemetry.measure(1, [&] {
+                      return static_cast<int>(std::floor(incremental->evaluateIncremental(
+                          nextState, actions[successorIndex - 1], nodes[currentIndex].heuristicTerms, childTerms)));
+                  })
+                : static_cast<int>(std::floor(batchValues[successorIndex - 1]));
+            int f = g + h;
+            #ifdef DEBUG
+            if (partialExpansion && bandBounds[successorIndex - 1] > f) {
+                std::cerr << "[ERROR] Partial expansion bound " << bandBounds[successorIndex - 1]
+                          << " above f " << f << " after: " << nextState.lastAction << std::endl;
+                abort();
+            }
+            #endif
 
             if (verbose) {
                 std::cout << "  " << successorIndex << ". " << nextState.lastAction 
                           << " → g=" << g << ", h=" << h << ", f=" << f;
                 if (nextState.crane.hasContainer) {
-                    std::cout << " (holding " << nextState.crane.containerId << ")";
+                    std::cout << " (holding " << nextState.crane.getHeldContainer()->getId() << ")";
                 }
                 std::cout << std::endl;
             }
 
-            auto nextNode = std::make_shared<AStarNode>(nextState, g, h, current);
-            openSet.push(nextNode);
+            uint32_t nextIndex = nodes.emplace(stackCells.share(nextState, currentState, nodes[currentIndex].state),
+                                               g, h, currentIndex);
+            #ifdef DEBUG
+            if (!stackCells.restore(nodes[nextIndex].state).sameConfiguration(nextState)) {
+                std::cerr << "[ERROR] Shared stacks do not restore after: " << nextState.lastAction << std::endl;
+                abort();
+            }
+            #endif
+            nodes[nextIndex].heuristicTerms = std::move(childTerms);
+            nodes[currentIndex].liveChildren++;
+            entry->node = nextIndex;
+            openSet->push(nodes[nextIndex].key(), nextIndex);
             nodesGenerated++;
 
             if (verbose && nodesGenerated % 500 == 0) {
                 std::cout << "  Generated " << nodesGenerated << " nodes..." << std::endl;
             }
         }
+
+        if (nextBound != INT_MAX) {
+            // Successors above poppedF were only bounded, not built: queue
+            // the node again under the smallest such bound
+            AStarNode& deferred = nodes[currentIndex];
+            deferred.expandedBound = poppedF;
+            deferred.liveChildren++;
+            openSet->push(packSearchKey(nextBound, deferred.state.current_time), currentIndex);
+        }
+
+        if (nodes[currentIndex].liveChildren == 0) {
+            releaseNode(currentIndex);
+        }
     }
     
+    fingerprintCollisions = static_cast<int>(stateTable.getKeyCollisions());
+    peakNodeBytes = nodes.peakSize() * sizeof(AStarNode) + stackCells.peakBytes();
+    nodes.clear();
+    stackCells.clear();
+
+    return finishSearch(startTime);
+}
+
+CompleteSolution AStarSolver::makeCompleteSolution(std::vector<AStarState> path, int g) const {
+    CompleteSolution completeSol;
+    completeSol.path = std::move(path);
+    const AStarState& goal = completeSol.path.back();
+    completeSol.totalCost = g + goal.current_time * 0.001;
+    completeSol.totalLateness = goal.getTotalLateness();
+    completeSol.finishTime = goal.current_time;
+    completeSol.suboptimalityBound = 1.0;
+    completeSol.nodesExpandedWhenFound = nodesExpanded;
+    
+    for (size_t i = 0; i < std::min(completeSol.path.size(), size_t(5)); i++) {
+        completeSol.keyMoves.push_back(completeSol.path[i].lastAction.toString());
+    }
+    if (completeSol.path.size() > 7) {
+        completeSol.keyMoves.push_back("...");
+        for (size_t i = completeSol.path.size() - 2; i < completeSol.path.size(); i++) {
+            completeSol.keyMoves.push_back(completeSol.path[i].lastAction.toString());
+        }
+    }
+    return completeSol;
+}
+
+void AStarSolver::publishSolution(const CompleteSolution& completeSol) {
+    allSolutions.push_back(completeSol);
+    if (solutionCallback) {
+        solutionCallback(completeSol);
+    }
+}
+
+void AStarSolver::tightenPublishedBound(double bound) {
+    CompleteSolution& last = allSolutions.back();
+    last.suboptimalityBound = bound;
+    if (solutionCallback) {
+        solutionCallback(last);
+    }
+}
+
+AStarSolution AStarSolver::finishSearch(std::chrono::high_resolution_clock::time_point startTime) {
+    AStarSolution solution;
+
     std::sort(allSolutions.begin(), allSolutions.end(),
         [](const CompleteSolution& a, const CompleteSolution& b) {
-            if (std::abs(a.totalCost - b.totalCost) < 0.01) {
+            // Lateness is a whole number of seconds, so these compare exactly
+            if (a.totalLateness != b.totalLateness) {
                 return a.totalLateness < b.totalLateness;
             }
-            return a.totalCost < b.totalCost;
+            return a.finishTime < b.finishTime;
         });
     
     // Return the best solution 
     auto endTime = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> elapsed = endTime - startTime;
     searchElapsedTime = elapsed.count();
+
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        peakResidentKb = usage.ru_maxrss;
+    }
     
     if (!allSolutions.empty()) {
         solution.found = true;
+        telemetry.recordSolutionPath(allSolutions[0].path, *heuristic);
             // Save best solution moves to separate file
         std::ofstream movesFile("BestSolutionMoves.txt");
         for (size_t i = 1; i < allSolutions[0].path.size(); ++i) {
@@ -237,6 +439,7 @@ AStarSolution AStarSolver::solve(const AStarState& initialState) {
         movesFile.close();
         solution.path = allSolutions[0].path;
         solution.totalCost = allSolutions[0].totalCost;
+        solution.suboptimalityBound = allSolutions[0].suboptimalityBound;
         solution.nodesExpanded = nodesExpanded;
         solution.nodesGenerated = nodesGenerated;
         solution.searchElapsedTime = elapsed.count();
@@ -259,23 +462,35 @@ AStarSolution AStarSolver::solve(const AStarState& initialState) {
     return solution;
 }
 
-std::vector<AStarState> AStarSolver::reconstructPath(std::shared_ptr<AStarNode> goalNode) const {
+void AStarSolver::releaseNode(uint32_t index) {
+    while (true) {
+        uint32_t parent = nodes[index].parent;
+        stackCells.release(nodes[index].state);
+        nodes.recycle(index);
+        if (parent == NodeArena<AStarNode>::NONE || --nodes[parent].liveChildren > 0) {
+            return;
+        }
+        index = parent;
+    }
+}
+
+std::vector<AStarState> AStarSolver::reconstructPath(uint32_t goalNode) const {
     std::vector<AStarState> path;
     
-    auto current = goalNode;
-    while (current != nullptr) {
-        path.push_back(current->state);
-        current = current->parent;
+    uint32_t current = goalNode;
+    while (current != NodeArena<AStarNode>::NONE) {
+        path.push_back(stackCells.restore(nodes[current].state));
+        current = nodes[current].parent;
     }
     
     std::reverse(path.begin(), path.end());
     return path;
 }
 
-void AStarSolver::printSearchProgress(int expanded, int queueSize, double bestF) const {
+void AStarSolver::printSearchProgress(int expanded, int queueSize, int bestF) const {
     std::cout << "Progress: Expanded=" << std::setw(6) << expanded 
               << ", Queue=" << std::setw(6) << queueSize 
-              << ", Best f=" << std::fixed << std::setprecision(2) << bestF 
+              << ", Best f=" << bestF 
               << std::endl;
 }
 
@@ -284,21 +499,40 @@ void AStarSolver::printStatistics() const {
     std::cout << "Nodes expanded: " << nodesExpanded << std::endl;
     std::cout << "Nodes generated: " << nodesGenerated << std::endl;
     std::cout << "Duplicates detected: " << duplicatesDetected << std::endl;
+    if (verifyFingerprints) {
+        std::cout << "Fingerprint collisions: " << fingerprintCollisions << std::endl;
+    }
+    if (partialExpansion && searchMode == SearchMode::SEQUENTIAL) {
+        std::cout << "Partial re-expansions: " << partialReexpansions << std::endl;
+    }
+    std::cout << "Heuristic: " << heuristic->getName() << std::endl;
+    heuristic->printStatistics();
+    telemetry.printSummary(std::cout);
+    if (!heuristicReportFile.empty()) {
+        std::ofstream reportFile(heuristicReportFile);
+        if (reportFile) {
+            writeHeuristicReport(reportFile);
+            std::cout << "Heuristic report written to " << heuristicReportFile << std::endl;
+        }
+    }
     std::cout << "Solutions found: " << allSolutions.size() << std::endl; 
     std::cout << "Solutions time: " << searchElapsedTime << std::endl;
+    double nodesPerSecond = searchElapsedTime > 0 ? nodesExpanded / searchElapsedTime : 0;
+    std::cout << "Nodes expanded per second: " << static_cast<long>(nodesPerSecond) << std::endl;
+    std::cout << "Node arena peak: " << peakNodeBytes / 1024 << " KB"
+              << (nodes.usesHugePages() ? " (huge pages)" : "") << std::endl;
+    std::cout << "Peak resident memory: " << peakResidentKb << " KB" << std::endl;
+    stateTable.printStatistics();
     double branchingFactor = nodesExpanded > 0 ? 
         static_cast<double>(nodesGenerated) / nodesExpanded : 0;
     std::cout << "Effective branching factor: " << std::fixed 
               << std::setprecision(2) << branchingFactor << std::endl;
 }
 
-double AStarSolver::calculateSimpleCost(const AStarState& state, 
-                                       std::shared_ptr<AStarNode> parentNode) const {
-        // Primary cost: actual lateness
-    double cost = state.getTotalLateness();
-    
-    // Tiny tie-breaker: prefer fewer moves 
-    cost += state.current_time * 0.001;
+int AStarSolver::calculateSimpleCost(const AStarState& state, uint32_t parentNode) const {
+        // Primary cost: actual lateness. Ties are broken on current_time by the
+    // open list key rather than by a fractional cost term.
+    int cost = static_cast<int>(state.getTotalLateness());
     
     static int debugCount = 0;
     if (debugCount < 10 && verbose) {
@@ -309,24 +543,40 @@ double AStarSolver::calculateSimpleCost(const AStarState& state,
     return cost;
 }
 
-int AStarSolver::calculateMoveCount(const AStarState& state, 
-                                   std::shared_ptr<AStarNode> parentNode) const {
-    if (!parentNode) {
+int AStarSolver::evaluateHeuristic(const AStarState& state) const {
+    // True lateness is whole seconds, so rounding an admissible bound down keeps it admissible
+    return telemetry.measure(1, [&] { return static_cast<int>(std::floor(heuristic->evaluate(state))); });
+}
+
+void AStarSolver::writeHeuristicReport(std::ostream& out) const {
+    const char* mode = "sequential";
+    switch (searchMode) {
+        case SearchMode::SEQUENTIAL: mode = "sequential"; break;
+        case SearchMode::PARALLEL_HDA: mode = "parallel-hda"; break;
+        case SearchMode::IDA_STAR: mode = "ida-star"; break;
+        case SearchMode::ANYTIME_ARA: mode = "anytime-ara"; break;
+        case SearchMode::FOCAL: mode = "focal"; break;
+    }
+    telemetry.writeReport(out, heuristic->getName(), mode);
+}
+
+int AStarSolver::calculateMoveCount(const AStarState& state, uint32_t parentNode) const {
+    if (parentNode == NodeArena<AStarNode>::NONE) {
         return 0; 
     }
     
     // Count moves by tracing back through parent chain
     int moveCount = 0;
-    auto current = parentNode;
+    uint32_t current = parentNode;
     
     // Trace back to root, counting each step
-    while (current != nullptr && current->parent != nullptr) {
+    while (nodes[current].parent != NodeArena<AStarNode>::NONE) {
         moveCount++;
-        current = current->parent;
+        current = nodes[current].parent;
     }
     
     // Add 1 for the current move (from parent to this state)
-    if (state.lastAction != "Initial state" && state.lastAction != "") {
+    if (state.lastAction.kind != LastAction::INITIAL) {
         moveCount++;
     }
     
@@ -348,8 +598,7 @@ int AStarSolver::calculateIdlePeriods(const AStarState& state) const {
     return idlePeriods;
 }
 
-void AStarSolver::debugSimpleCost(const AStarState& state, 
-                                 std::shared_ptr<AStarNode> parentNode) const {
+void AStarSolver::debugSimpleCost(const AStarState& state, uint32_t parentNode) const {
     double lateness = state.getTotalLateness();
     int moves = calculateMoveCount(state, parentNode);
     int idle = calculateIdlePeriods(state);
@@ -1,7 +1,64 @@
 #include "AStarState.h"
+#include "Zobrist.h"
 #include <sstream>
 #include <algorithm>
 #include <iomanip>
+#include <stdexcept>
+
+void StackArray::addStack() {
+    if (stackCount == MAX_STACKS) {
+        throw std::runtime_error("A* state supports at most " + std::to_string(MAX_STACKS) + " stacks");
+    }
+    ends[stackCount] = stackCount == 0 ? 0 : ends[stackCount - 1];
+    stackCount++;
+}
+
+void StackArray::push(int stackIndex, ContainerIndex container) {
+    int total = ends[stackCount - 1];
+    if (total == MAX_CONTAINERS) {
+        throw std::runtime_error("A* state supports at most " + std::to_string(MAX_CONTAINERS) + " containers");
+    }
+    int at = ends[stackIndex];
+    std::copy_backward(slots + at, slots + total, slots + total + 1);
+    slots[at] = container;
+    for (int s = stackIndex; s < stackCount; s++) {
+        ends[s]++;
+    }
+}
+
+ContainerIndex StackArray::pop(int stackIndex) {
+    int at = ends[stackIndex] - 1;
+    int total = ends[stackCount - 1];
+    ContainerIndex container = slots[at];
+    std::copy(slots + at + 1, slots + total, slots + at);
+    for (int s = stackIndex; s < stackCount; s++) {
+        ends[s]--;
+    }
+    return container;
+}
+
+void StackArray::pushToExit(ContainerIndex container, int exitTime) {
+    int exitStack = stackCount - 1;
+    exitBottomTime = exitTime + static_cast<int>((*this)[exitStack].size()) * EXIT_INTERVAL;
+    push(exitStack, container);
+}
+
+std::string LastAction::toString() const {
+    const std::string& id = container == NO_CONTAINER ? std::string() : ContainerTable::get(container).id;
+    std::string pickUp = "Picked up " + id + " from stack " + std::to_string(fromStack);
+    std::string putDown = "Put down " + id + " on stack " + std::to_string(toStack) + (toExit ? " (EXIT)" : "");
+    switch (kind) {
+        case PICK_UP:  return pickUp;
+        case PUT_DOWN: return putDown;
+        case RELOCATE: return pickUp + ";;" + putDown;
+        case WAIT:     return "Waited for " + std::to_string(waitTime) + " seconds";
+        default:       return "Initial state";
+    }
+}
+
+std::ostream& operator<<(std::ostream& out, const LastAction& action) {
+    return out << action.toString();
+}
 
 std::string AStarState::getStateHash() const {
     std::stringstream ss;
@@ -27,6 +84,60 @@ std::string AStarState::getStateHash() const {
     return ss.str();
 }
 
+uint64_t AStarState::computeFingerprint() const {
+    uint64_t fp = ZobristKeys::craneKey(crane.position);
+    if (crane.getHeldContainer()) {
+        fp ^= ZobristKeys::heldKey(crane.heldContainer);
+    }
+
+    for (size_t i = 0; i < stacks.size(); i++) {
+        for (size_t j = 0; j < stacks[i].size(); j++) {
+            if (stacks[i][j].getExitTime() == -1) {
+                fp ^= ZobristKeys::placementKey(stacks[i][j].getIndex(), i, j);
+            }
+        }
+    }
+
+    return fp;
+}
+
+bool AStarState::sameConfiguration(const AStarState& other) const {
+    auto heldA = crane.getHeldContainer();
+    auto heldB = other.crane.getHeldContainer();
+
+    if (crane.position != other.crane.position || heldA.has_value() != heldB.has_value()) {
+        return false;
+    }
+    if (heldA && heldA->getIndex() != heldB->getIndex()) {
+        return false;
+    }
+
+    if (stacks.size() != other.stacks.size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < stacks.size(); i++) {
+        size_t a = 0, b = 0;
+        while (true) {
+            while (a < stacks[i].size() && stacks[i][a].getExitTime() != -1) a++;
+            while (b < other.stacks[i].size() && other.stacks[i][b].getExitTime() != -1) b++;
+            if (a == stacks[i].size() || b == other.stacks[i].size()) {
+                break;
+            }
+            if (a != b || stacks[i][a].getIndex() != other.stacks[i][b].getIndex()) {
+                return false;
+            }
+            a++;
+            b++;
+        }
+        if (a != stacks[i].size() || b != other.stacks[i].size()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool AStarState::isGoalState() const {
     if (crane.getHeldContainer()) {
         return false;
@@ -197,7 +308,7 @@ bool AStarState::canPutDownOn(int stackIndex, int bufferSize) const {
 
     if (!stacks[stackIndex].empty()) {
     const auto& topContainer = stacks[stackIndex].back();
-    const auto& heldContainer = crane.heldContainer.value();
+    ContainerView heldContainer(crane.heldContainer);
     
     // Calculate due times for comparison
     int topContainerDueTime = topContainer.getArrivalTime() + topContainer.getDueIn();
@@ -238,28 +349,16 @@ void AStarState::setTotalLateness(int late) {
     totalAccumulatedLateness += late;
 }
 
-UntilDueContainer* AStarState::getTopContainer(int stackIndex) {
-    if (stackIndex < 0 || stackIndex >= static_cast<int>(stacks.size())) {
-        return nullptr;
-    }
-
-    if (stacks[stackIndex].empty()) {
-        return nullptr;
-    }
-
-    return &stacks[stackIndex].back();
-}
-
-const UntilDueContainer* AStarState::getTopContainer(int stackIndex) const {
+std::optional<ContainerView> AStarState::getTopContainer(int stackIndex) const {
     if (stackIndex < 0 || stackIndex >= static_cast<int>(stacks.size())) {
-        return nullptr;
+        return std::nullopt;
     }
 
     if (stacks[stackIndex].empty()) {
-        return nullptr;
+        return std::nullopt;
     }
 
-    return &stacks[stackIndex].back();
+    return stacks[stackIndex].back();
 }
 
 bool AStarState::operator==(const AStarState& other) const {
@@ -267,15 +366,15 @@ bool AStarState::operator==(const AStarState& other) const {
         return false;
     }
 
-    bool holdingA = (crane.getHeldContainer() != nullptr);
-    bool holdingB = (other.crane.getHeldContainer() != nullptr);
+    bool holdingA = crane.getHeldContainer().has_value();
+    bool holdingB = other.crane.getHeldContainer().has_value();
 
     if (crane.position != other.crane.position || holdingA != holdingB) {
         return false;
     }
 
     if (holdingA && holdingB) {
-        if (crane.getHeldContainer()->getId() != other.crane.getHeldContainer()->getId()) {
+        if (crane.heldContainer != other.crane.heldContainer) {
             return false;
         }
     }
@@ -291,7 +390,7 @@ bool AStarState::operator==(const AStarState& other) const {
 
         for (size_t j = 0; j < stacks[i].size(); j++) {
             if (stacks[i][j].getExitTime() == -1 || other.stacks[i][j].getExitTime() == -1) {
-                if (stacks[i][j].getId() != other.stacks[i][j].getId() ||
+                if (stacks[i][j].getIndex() != other.stacks[i][j].getIndex() ||
                     stacks[i][j].getDueIn() != other.stacks[i][j].getDueIn()) {
                     return false;
                 }
@@ -0,0 +1,237 @@
+#include "AStarSolver.h"
+#include "StateCopies.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+// Anytime repairing A* (ARA*). The search starts as weighted A* ordered on
+// g + w*h and lowers w after every solution. Instead of restarting, each
+// round reuses the nodes and best g-values of the previous ones: a state
+// whose g improves after it was expanded in the current round is parked in
+// INCONS and only reconsidered in the next round, so no state is expanded
+// twice per round.
+//
+// Rounds look at a state again only when it improves on every copy seen so
+// far, as in StateCopies.h, so OPEN and INCONS together keep every state
+// that can still lead to a better plan. Every improved plan is published
+// once, with the bound
+//     lateness / min over OPEN and INCONS of (g + h),
+// which holds for any admissible h. w itself is no bound: that would need a
+// consistent h, and LatenessHeuristic is not. A later round that only
+// tightens the bound of the same plan updates the published one in place.
+
+namespace {
+
+struct AraNode {
+    AStarState state;
+    int g;
+    int h;
+    uint32_t parent;
+    int closedRound;      // round in which this node was expanded, -1 if never
+    uint32_t nextCopy = NodeArena<AraNode>::NONE;
+    bool superseded = false;
+
+    AraNode(AStarState s, int gCost, int hCost, uint32_t p)
+        : state(std::move(s)), g(gCost), h(hCost), parent(p), closedRound(-1) {}
+};
+
+uint64_t weightedKey(const AraNode& node, double weight) {
+    int f = node.g + static_cast<int>(std::lround(weight * node.h));
+    return packSearchKey(f, node.state.current_time);
+}
+
+}
+
+AStarSolution AStarSolver::solveAnytime(const AStarState& initialState) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    initialContainerCount = initialState.getUnexitedContainers();
+
+    nodesExpanded = 0;
+    nodesGenerated = 0;
+    duplicatesDetected = 0;
+    fingerprintCollisions = 0;
+    allSolutions.clear();
+
+    // Nodes are never recycled, so a superseded copy still sitting in OPEN
+    // can be recognised when it comes up
+    NodeArena<AraNode> araNodes;
+    // Keyed by StateCopies::key(): configuration ranks are only used by solve()
+    stateRanking.reset();
+    stateTable.setDenseStates(0);
+    stateTable.clear();
+    stateTable.reserve(std::min(static_cast<size_t>(std::max(maxNodes, 0)), MAX_PRESIZED_STATES));
+
+    double weight = std::max(anytimeInitialWeight, 1.0);
+    double step = anytimeWeightStep > 0 ? anytimeWeightStep : 1.0;
+
+    AStarState root = initialState;
+    root.fingerprint = initialState.computeFingerprint();
+    int g0 = static_cast<int>(root.getTotalLateness());
+    uint32_t rootIndex = araNodes.emplace(std::move(root), g0, evaluateHeuristic(initialState), NodeArena<AraNode>::NONE);
+    bool inserted;
+    StateTable::Entry& rootEntry = stateTable.findOrInsert(StateCopies::key(araNodes[rootIndex].state), inserted);
+    rootEntry.node = rootIndex;
+    nodesGenerated++;
+
+    std::unique_ptr<IOpenList> openSet = makeOpenList(openListType);
+    openSet->push(weightedKey(araNodes[rootIndex], weight), rootIndex);
+    std::vector<uint32_t> incons;
+
+    uint64_t incumbentKey = std::numeric_limits<uint64_t>::max();
+    uint32_t incumbent = NodeArena<AraNode>::NONE;
+    uint32_t published = NodeArena<AraNode>::NONE;
+    double publishedBound = std::numeric_limits<double>::infinity();
+    bool enoughSolutions = false;
+
+    if (verbose) {
+        std::cout << "\n=== ARA* Search Started ===" << std::endl;
+        std::cout << "Weight schedule: " << weight << " down by " << step << std::endl;
+        std::cout << "Max nodes limit: " << maxNodes << std::endl;
+    }
+
+    auto isCurrent = [&](uint32_t index) { return !araNodes[index].superseded; };
+
+    // The time limit only cuts the search short once there is a plan to
+    // return; until then it runs on to maxNodes like solve()
+    auto outOfTime = [&]() {
+        if (anytimeTimeLimit <= 0 || incumbent == NodeArena<AraNode>::NONE) {
+            return false;
+        }
+        std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - startTime;
+        return elapsed.count() >= anytimeTimeLimit;
+    };
+
+    int round = 0;
+    bool stopped = false;
+    while (true) {
+        // ImprovePath: expand until the incumbent is no worse than the best weighted key
+        while (!openSet->empty() && openSet->topKey() < incumbentKey) {
+            if (nodesExpanded >= maxNodes || ((nodesExpanded & 1023) == 0 && outOfTime())) {
+                stopped = true;
+                break;
+            }
+
+            uint32_t currentIndex = openSet->pop();
+            if (!isCurrent(currentIndex)) {
+                duplicatesDetected++;
+                continue;
+            }
+            if (araNodes[currentIndex].state.isGoalState()) {
+                continue;
+            }
+            araNodes[currentIndex].closedRound = round;
+            nodesExpanded++;
+
+            auto successors = generator->generateSuccessors(araNodes[currentIndex].state);
+            for (auto& successor : successors) {
+                AStarState& nextState = successor.first;
+                int g = static_cast<int>(nextState.getTotalLateness());
+                uint64_t gKey = packSearchKey(g, nextState.current_time);
+
+                StateTable::Entry& entry = stateTable.findOrInsert(StateCopies::key(nextState), inserted);
+                if (inserted) {
+                    entry.node = NodeArena<AraNode>::NONE;
+                }
+                // Improving on a copy expanded this round parks the new copy in INCONS
+                bool closedThisRound = false;
+                if (!StateCopies::admit(araNodes, entry.node, g, nextState, [&](const AraNode& copy) {
+                        closedThisRound = closedThisRound || copy.closedRound == round;
+                    })) {
+                    duplicatesDetected++;
+                    continue;
+                }
+
+                int h = evaluateHeuristic(nextState);
+                uint32_t nextIndex = araNodes.emplace(std::move(nextState), g, h, currentIndex);
+                araNodes[nextIndex].nextCopy = entry.node;
+                entry.node = nextIndex;
+                nodesGenerated++;
+
+                const AraNode& next = araNodes[nextIndex];
+                if (next.state.isGoalState() && gKey < incumbentKey) {
+                    incumbentKey = gKey;
+                    incumbent = nextIndex;
+                }
+                if (closedThisRound) {
+                    incons.push_back(nextIndex);
+                } else {
+                    openSet->push(weightedKey(next, weight), nextIndex);
+                }
+            }
+        }
+
+        // Collect OPEN and INCONS; their smallest unweighted f bounds the optimum from below
+        std::vector<uint32_t> pending;
+        int minF = INT_MAX;
+        auto collect = [&](uint32_t index) {
+            if (isCurrent(index) && !araNodes[index].state.isGoalState()) {
+                pending.push_back(index);
+                minF = std::min(minF, araNodes[index].g + araNodes[index].h);
+            }
+        };
+        while (!openSet->empty()) {
+            collect(openSet->pop());
+        }
+        for (uint32_t index : incons) {
+            collect(index);
+        }
+        incons.clear();
+
+        if (incumbent != NodeArena<AraNode>::NONE) {
+            int lateness = araNodes[incumbent].g;
+            double bound = std::numeric_limits<double>::infinity();
+            if (minF == INT_MAX || lateness <= minF) {
+                bound = 1.0;
+            } else if (minF > 0) {
+                bound = static_cast<double>(lateness) / minF;
+            }
+            if (incumbent != published || bound < publishedBound) {
+                if (incumbent != published) {
+                    std::vector<AStarState> path;
+                    for (uint32_t i = incumbent; i != NodeArena<AraNode>::NONE; i = araNodes[i].parent) {
+                        path.push_back(araNodes[i].state);
+                    }
+                    std::reverse(path.begin(), path.end());
+                    CompleteSolution completeSol = makeCompleteSolution(std::move(path), lateness);
+                    completeSol.suboptimalityBound = bound;
+                    publishSolution(completeSol);
+                    published = incumbent;
+                    enoughSolutions = allSolutions.size() >= maxSolutionsToFind;
+                } else {
+                    tightenPublishedBound(bound);
+                }
+                publishedBound = bound;
+
+                if (verbose) {
+                    std::cout << "ARA* round " << round << " (w=" << weight << "): lateness "
+                              << lateness << ", bound " << bound << ", "
+                              << nodesExpanded << " expanded" << std::endl;
+                }
+            }
+            if (bound <= 1.0 || enoughSolutions) {
+                if (verbose && enoughSolutions && bound > 1.0) {
+                    std::cout << "Found " << maxSolutionsToFind << " solutions. Stopping search." << std::endl;
+                }
+                break;
+            }
+        }
+
+        // With an inconsistent h, INCONS can still hold a better path at w = 1
+        if (stopped || pending.empty()) {
+            break;
+        }
+
+        weight = std::max(1.0, weight - step);
+        round++;
+        openSet = makeOpenList(openListType);
+        for (uint32_t index : pending) {
+            openSet->push(weightedKey(araNodes[index], weight), index);
+        }
+    }
+
+    peakNodeBytes = araNodes.peakSize() * sizeof(AraNode);
+
+    return finishSearch(startTime);
+}
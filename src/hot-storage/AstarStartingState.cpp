@@ -10,6 +10,10 @@ AStarState makeAStarInitialState(ParsedBuffers& parsedBuffers) {
 }
 
 AStarState makeAStarCurrentState(ParsedBuffers& parsedBuffers, int currentSystemTime, SingleContainerCrane* crane) {
+    // Every plan interns its own containers, so repeated replans and
+    // training runs do not pile up entries
+    ContainerTable::reset();
+
     AStarState state;
     state.current_time = currentSystemTime;
     state.consecutiveWaits = 0;
@@ -22,46 +26,42 @@ AStarState makeAStarCurrentState(ParsedBuffers& parsedBuffers, int currentSystem
             void* hookContent = crane->getHookContent();
             UntilDueContainer* container = static_cast<UntilDueContainer*>(hookContent);
             if (container) {
-                state.crane.containerId = container->getId();
+                UntilDue ud = container->getUntilDue();
+                state.crane.heldContainer = ContainerTable::intern(container->getId(), 0,
+                                                                   untilDueToSeconds(ud) + currentSystemTime);
             }
         }
     } else {
         state.crane.position = 0;
         state.crane.hasContainer = false;
-        state.crane.containerId = "";
+        state.crane.heldContainer = NO_CONTAINER;
     }
 
     auto buffers = parsedBuffers.getBuffers();
     
     for (size_t bufferIndex = 0; bufferIndex < buffers.size(); bufferIndex++) {
-        std::vector<UntilDueContainer> stack;
+        state.stacks.addStack();
         
         if(bufferIndex != 4){
             for (auto containerPtr : buffers[bufferIndex]->getContainers()) {
                 auto udc = dynamic_cast<UntilDueContainer*>(containerPtr);
                 if (udc) {
-                    UntilDueContainer container = *udc;
-                    
                     UntilDue ud = udc->getUntilDue();
                     int dueInSeconds = untilDueToSeconds(ud);
                     
-                    container.setDueIn(dueInSeconds + currentSystemTime);
-                    
-                    container.setArrivalTime(0);
-                    
-                    container.setExitTime(-1);
-                    
-                    stack.push_back(container);
+                    // Arrival is the planning start, due times are absolute
+                    state.stacks.push(bufferIndex, ContainerTable::intern(udc->getId(), 0,
+                                                                          dueInSeconds + currentSystemTime));
                 }
             }
         }
-        
-        state.stacks.push_back(stack);
     }
     
+    state.fingerprint = state.computeFingerprint();
+
     // If crane is carrying a container, we need to add it to the state
     if (crane != nullptr && state.crane.hasContainer) {
-        std::cout << "Crane is currently carrying container: " << state.crane.containerId << std::endl;
+        std::cout << "Crane is currently carrying container: " << state.crane.toString() << std::endl;
     }
     
     #ifdef DEBUG
@@ -71,34 +71,9 @@ AStarState makeAStarCurrentState(ParsedBuffers& parsedBuffers, int currentSystem
     return state;
 }
 
-// Helper function to update all container due times when time passes
+// Helper function to let time pass: due times are absolute in the
+// container table, so only the clock moves
 void updateContainerDueTimes(AStarState& state, int elapsedTime) {
-    for (auto& stack : state.stacks) {
-        for (auto& container : stack) {
-            if (container.getExitTime() == -1) {  // Only update unexited containers
-                // Get current due time
-                int currentDueIn = container.getDueIn();
-                
-                // Subtract elapsed time
-                currentDueIn -= elapsedTime;
-                
-                // Handle negative time (overdue)
-                if (currentDueIn < 0) {
-                    currentDueIn = 0;  // Container is overdue
-                }
-                
-                // Update the container's due time
-                container.setDueIn(currentDueIn);
-                
-                // Also update the UntilDue object for consistency
-                int newMinutes = currentDueIn / 60;
-                int newSeconds = currentDueIn % 60;
-                UntilDue newDue(newMinutes, newSeconds);
-                container.setUntilDue(newDue);
-            }
-        }
-    }
-    
     state.current_time += elapsedTime;
 }
 
@@ -110,7 +85,7 @@ void printCurrentStateInfo(const AStarState& state, int systemTime) {
     std::cout << "Crane position: Stack " << state.crane.position << std::endl;
     std::cout << "Crane has container: " << (state.crane.hasContainer ? "Yes" : "No") << std::endl;
     if (state.crane.hasContainer) {
-        std::cout << "Crane container ID: " << state.crane.containerId << std::endl;
+        std::cout << "Crane container ID: " << state.crane.getHeldContainer()->getId() << std::endl;
     }
     
     std::cout << "\nStacks configuration:" << std::endl;
@@ -0,0 +1,83 @@
+#include "BlockingHeuristic.h"
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+BlockingHeuristic::BlockingHeuristic(const ParsedBuffers& buffers) : base(buffers) {
+    craneMoveTime = base.getCraneMoveTime();
+    craneLowerTime = base.getCraneLowerTime();
+    craneLiftTime = base.getCraneLiftTime();
+    exitCycleTime = 2 * (craneLowerTime + craneLiftTime + craneMoveTime);
+    // Lift, pick up anywhere, move at least one stack, lower
+    putDownGap = 2 * (craneLowerTime + craneLiftTime) + craneMoveTime;
+}
+
+double BlockingHeuristic::evaluate(const AStarState& state) const {
+    return std::max(blockingLateness(state), base.evaluate(state));
+}
+
+double BlockingHeuristic::blockingLateness(const AStarState& state) const {
+    int exitStack = static_cast<int>(state.stacks.size()) - 1;
+    int now = state.current_time;
+    auto held = state.crane.getHeldContainer();
+
+    std::vector<Item> items = ExitSlotHeuristic::releaseTimes(state, craneMoveTime, craneLowerTime, craneLiftTime);
+    std::vector<int> heights(exitStack, 0);
+    for (int s = 0; s < exitStack; s++) {
+        heights[s] = static_cast<int>(state.stacks[s].size());
+    }
+    if (items.empty()) {
+        return 0.0;
+    }
+
+    std::sort(items.begin(), items.end(),
+        [](const Item& a, const Item& b) { return a.dueTime < b.dueTime; });
+
+    // Bound for S empty: every container on its own
+    long long outside = 0;
+    for (const auto& item : items) {
+        outside += std::max(0, item.release - item.dueTime);
+    }
+    long long best = outside;
+
+    // The first put-down of any kind, and how many containers must be put down before S is out
+    int firstPutDown = held ? now + craneMoveTime + craneLowerTime
+                            : now + craneLowerTime + craneLiftTime + craneMoveTime + craneLowerTime;
+    std::vector<int> lowest(heights);
+    int closure = 0;
+    bool heldInside = false;
+
+    std::vector<int> releases;
+    releases.reserve(items.size());
+    for (size_t k = 0; k < items.size(); k++) {
+        const Item& item = items[k];
+        outside -= std::max(0, item.release - item.dueTime);
+        releases.insert(std::upper_bound(releases.begin(), releases.end(), item.release), item.release);
+
+        if (item.stack < 0) {
+            heldInside = true;
+            closure++;
+        } else if (item.height < lowest[item.stack]) {
+            // Everything above the new lowest member of S in this stack has to move first
+            closure += lowest[item.stack] - item.height;
+            lowest[item.stack] = item.height;
+        }
+        // Two exits of S are an exit cycle apart, and each other put-down
+        // between them adds at least one more gap
+        int others = closure - static_cast<int>(k + 1) + (held && !heldInside ? 1 : 0);
+        int finish = firstPutDown + static_cast<int>(k) * exitCycleTime + others * putDownGap;
+
+        // Items are in due order, so matching the j-th slot to items[j] pairs both sorted
+        long long inside = 0;
+        int slot = 0;
+        for (size_t j = 0; j <= k; j++) {
+            slot = j == 0 ? releases[0] : std::max(slot + exitCycleTime, releases[j]);
+            if (j == k) {
+                slot = std::max(slot, finish);
+            }
+            inside += std::max(0, slot - items[j].dueTime);
+        }
+        best = std::max(best, inside + outside);
+    }
+    return static_cast<double>(best);
+}
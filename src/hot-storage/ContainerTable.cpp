@@ -0,0 +1,51 @@
+#include "ContainerTable.h"
+#include "Zobrist.h"
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+
+std::unique_ptr<ContainerTable::Entry[]> ContainerTable::chunks[ContainerTable::CHUNK_COUNT];
+
+namespace {
+
+std::mutex internMutex;
+std::map<std::tuple<std::string, int, int>, ContainerIndex> internedIndices;
+size_t entryCount = 0;
+
+}
+
+ContainerIndex ContainerTable::intern(const std::string& id, int arrivalTime, int dueIn) {
+    std::lock_guard<std::mutex> lock(internMutex);
+    auto key = std::make_tuple(id, arrivalTime, dueIn);
+    auto it = internedIndices.find(key);
+    if (it != internedIndices.end()) {
+        return it->second;
+    }
+
+    if (entryCount >= NO_CONTAINER) {
+        throw std::runtime_error("Container table is full, cannot intern " + id);
+    }
+    ContainerIndex index = static_cast<ContainerIndex>(entryCount);
+    auto& chunk = chunks[index >> CHUNK_BITS];
+    if (!chunk) {
+        chunk = std::make_unique<Entry[]>(CHUNK_SIZE);
+    }
+    chunk[index & (CHUNK_SIZE - 1)] = {arrivalTime, dueIn, ZobristKeys::containerKey(id), id};
+    entryCount++;
+
+    internedIndices.emplace(std::move(key), index);
+    return index;
+}
+
+size_t ContainerTable::size() {
+    std::lock_guard<std::mutex> lock(internMutex);
+    return entryCount;
+}
+
+void ContainerTable::reset() {
+    std::lock_guard<std::mutex> lock(internMutex);
+    // Chunks stay allocated for the next plan
+    internedIndices.clear();
+    entryCount = 0;
+}
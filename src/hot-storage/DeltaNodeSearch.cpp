@@ -0,0 +1,237 @@
+#include "AStarSolver.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <iostream>
+
+// Sequential A* with delta-encoded nodes, for searches whose maxNodes full
+// nodes would not fit the node budget. A node keeps the move that
+// produced it, its parent, g and h; only every snapshotInterval-th ply
+// stores a state (with stacks shared through the StackCellPool). A state is
+// rebuilt by replaying the moves from the nearest ancestor snapshot, at most
+// snapshotInterval - 1 of them per expansion.
+//
+// Everything else follows solve(): same open list, duplicate pruning,
+// node recycling and solution handling. States are keyed by fingerprint and
+// successors are scored in one batch, so partial expansion, configuration
+// ranks and exact keys do not apply here.
+
+namespace {
+
+struct DeltaNode {
+    LastAction action;      // replayed on the parent's state to rebuild this one
+    uint32_t parent;
+    uint32_t snapshot;      // stored state, NodeArena NONE between snapshots
+    int g;
+    int h;
+    int f;
+    int time;               // current_time of the state, for the open-list key
+    uint32_t liveChildren;
+    uint16_t depth;
+
+    DeltaNode(const LastAction& a, uint32_t p, uint32_t s, int gCost, int hCost, int t, uint16_t d)
+        : action(a), parent(p), snapshot(s), g(gCost), h(hCost), f(gCost + hCost), time(t),
+          liveChildren(0), depth(d) {}
+
+    uint64_t key() const { return packSearchKey(f, time); }
+};
+
+constexpr uint32_t NONE = NodeArena<DeltaNode>::NONE;
+
+}
+
+bool AStarSolver::needsDeltaNodes() const {
+    return searchMode == SearchMode::SEQUENTIAL && nodeBudgetBytes > 0 &&
+           static_cast<size_t>(std::max(maxNodes, 0)) * sizeof(AStarNode) > nodeBudgetBytes;
+}
+
+AStarSolution AStarSolver::solveDeltaNodes(const AStarState& initialState) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    initialContainerCount = initialState.getUnexitedContainers();
+
+    nodesExpanded = 0;
+    nodesGenerated = 0;
+    duplicatesDetected = 0;
+    fingerprintCollisions = 0;
+    allSolutions.clear();
+
+    NodeArena<DeltaNode> deltaNodes;
+    NodeArena<SharedState> snapshots;
+    stackCells.clear();
+    // Keyed by fingerprint: configuration ranks are only used by solve()
+    stateRanking.reset();
+    stateTable.setDenseStates(0);
+    stateTable.clear();
+    stateTable.reserve(std::min(static_cast<size_t>(std::max(maxNodes, 0)), MAX_PRESIZED_STATES));
+
+    // State of a node: its nearest snapshot, then the moves below it
+    std::vector<uint32_t> replay;
+    uint64_t replayedMoves = 0;
+    auto rebuild = [&](uint32_t index, uint32_t& snapshotNode) {
+        replay.clear();
+        while (deltaNodes[index].snapshot == NONE) {
+            replay.push_back(index);
+            index = deltaNodes[index].parent;
+        }
+        snapshotNode = index;
+        AStarState state = stackCells.restore(snapshots[deltaNodes[index].snapshot]);
+        for (auto it = replay.rbegin(); it != replay.rend(); ++it) {
+            state = generator->applyAction(state, deltaNodes[*it].action);
+        }
+        replayedMoves += replay.size();
+        return state;
+    };
+
+    auto pathTo = [&](uint32_t goal) {
+        std::vector<uint32_t> chain;
+        for (uint32_t i = goal; i != NONE; i = deltaNodes[i].parent) {
+            chain.push_back(i);
+        }
+        std::vector<AStarState> path;
+        path.push_back(stackCells.restore(snapshots[deltaNodes[chain.back()].snapshot]));
+        for (auto it = chain.rbegin() + 1; it != chain.rend(); ++it) {
+            path.push_back(generator->applyAction(path.back(), deltaNodes[*it].action));
+        }
+        return path;
+    };
+
+    auto release = [&](uint32_t index) {
+        while (true) {
+            uint32_t parent = deltaNodes[index].parent;
+            uint32_t snapshot = deltaNodes[index].snapshot;
+            if (snapshot != NONE) {
+                stackCells.release(snapshots[snapshot]);
+                snapshots.recycle(snapshot);
+            }
+            deltaNodes.recycle(index);
+            if (parent == NONE || --deltaNodes[parent].liveChildren > 0) {
+                return;
+            }
+            index = parent;
+        }
+    };
+
+    AStarState root = initialState;
+    root.fingerprint = root.computeFingerprint();
+    int g0 = static_cast<int>(root.getTotalLateness());
+    int h0 = evaluateHeuristic(root);
+    uint32_t rootSnapshot = snapshots.emplace(stackCells.store(root));
+    uint32_t rootIndex = deltaNodes.emplace(root.lastAction, NONE, rootSnapshot, g0, h0, root.current_time, 0);
+    bool inserted;
+    StateTable::Entry& rootEntry = stateTable.findOrInsert(root.fingerprint, inserted);
+    rootEntry.bestG = packSearchKey(g0, root.current_time);
+    rootEntry.node = rootIndex;
+    nodesGenerated++;
+
+    std::unique_ptr<IOpenList> openSet = makeOpenList(openListType);
+    openSet->push(deltaNodes[rootIndex].key(), rootIndex);
+
+    if (verbose) {
+        std::cout << "\n=== Delta-node A* Search Started ===" << std::endl;
+        std::cout << "Node budget: " << nodeBudgetBytes / 1024 << " KB, snapshot every "
+                  << snapshotInterval << " plies" << std::endl;
+        std::cout << "Max nodes limit: " << maxNodes << std::endl;
+    }
+
+    std::vector<const AStarState*> batch;
+    std::vector<double> batchValues;
+
+    while (!openSet->empty() && nodesExpanded < maxNodes) {
+        uint32_t currentIndex = openSet->pop();
+        uint32_t snapshotNode;
+        const AStarState currentState = rebuild(currentIndex, snapshotNode);
+        const DeltaNode current = deltaNodes[currentIndex];
+
+        if (currentState.isGoalState()) {
+            publishSolution(makeCompleteSolution(pathTo(currentIndex), current.g));
+            release(currentIndex);
+            if (allSolutions.size() >= static_cast<size_t>(maxSolutionsToFind)) {
+                break;
+            }
+            continue;
+        }
+
+        StateTable::Entry& currentEntry = stateTable.findOrInsert(currentState.fingerprint, inserted);
+        if (currentEntry.closed) {
+            duplicatesDetected++;
+            if (current.liveChildren == 0) {
+                release(currentIndex);
+            }
+            continue;
+        }
+        currentEntry.closed = true;
+        nodesExpanded++;
+        telemetry.recordExpansion(current.f);
+
+        if (verbose && nodesExpanded % 100 == 0) {
+            printSearchProgress(nodesExpanded, openSet->size(), current.f);
+        }
+
+        auto successors = generator->generateSuccessors(currentState);
+        batch.clear();
+        for (const auto& successor : successors) {
+            batch.push_back(&successor.first);
+        }
+        batchValues.resize(batch.size());
+        telemetry.measure(batch.size(), [&] {
+            heuristic->evaluateBatch(batch.data(), batch.size(), batchValues.data());
+            return 0;
+        });
+
+        // Children a full interval below the parent's snapshot store their
+        // own, sharing stack cells with it
+        const SharedState& nearest = snapshots[deltaNodes[snapshotNode].snapshot];
+        const AStarState nearestState = current.depth + 1 - deltaNodes[snapshotNode].depth >= snapshotInterval
+            ? stackCells.restore(nearest)
+            : AStarState();
+
+        for (size_t i = 0; i < successors.size(); i++) {
+            const AStarState& nextState = successors[i].first;
+            int g = static_cast<int>(nextState.getTotalLateness());
+            uint64_t gKey = packSearchKey(g, nextState.current_time);
+
+            StateTable::Entry* entry = &stateTable.findOrInsert(nextState.fingerprint, inserted);
+            if (entry->bestG <= gKey) {
+                duplicatesDetected++;
+                continue;
+            }
+            entry->bestG = gKey;
+
+            #ifdef DEBUG
+            AStarState replayed = generator->applyAction(currentState, nextState.lastAction);
+            if (!replayed.sameConfiguration(nextState) || replayed.current_time != nextState.current_time ||
+                replayed.getTotalLateness() != nextState.getTotalLateness()) {
+                std::cerr << "[ERROR] Replaying does not rebuild: " << nextState.lastAction << std::endl;
+                abort();
+            }
+            #endif
+
+            uint16_t depth = static_cast<uint16_t>(current.depth + 1);
+            uint32_t snapshot = NONE;
+            if (depth - deltaNodes[snapshotNode].depth >= snapshotInterval) {
+                snapshot = snapshots.emplace(stackCells.share(nextState, nearestState, nearest));
+            }
+            int h = static_cast<int>(std::floor(batchValues[i]));
+            uint32_t nextIndex = deltaNodes.emplace(nextState.lastAction, currentIndex, snapshot, g, h,
+                                                    nextState.current_time, depth);
+            deltaNodes[currentIndex].liveChildren++;
+            entry->node = nextIndex;
+            openSet->push(deltaNodes[nextIndex].key(), nextIndex);
+            nodesGenerated++;
+        }
+
+        if (deltaNodes[currentIndex].liveChildren == 0) {
+            release(currentIndex);
+        }
+    }
+
+    if (verbose) {
+        std::cout << "Delta nodes: " << replayedMoves << " moves replayed, "
+                  << snapshots.peakSize() << " snapshots at peak" << std::endl;
+    }
+    peakNodeBytes = deltaNodes.peakSize() * sizeof(DeltaNode) + snapshots.peakSize() * sizeof(SharedState) +
+                    stackCells.peakBytes();
+    stackCells.clear();
+
+    return finishSearch(startTime);
+}
@@ -0,0 +1,70 @@
+#include "ExitSlotHeuristic.h"
+#include <algorithm>
+#include <cstdlib>
+
+ExitSlotHeuristic::ExitSlotHeuristic(const ParsedBuffers& buffers) : base(buffers) {
+    craneMoveTime = base.getCraneMoveTime();
+    craneLowerTime = base.getCraneLowerTime();
+    craneLiftTime = base.getCraneLiftTime();
+    exitCycleTime = 2 * (craneLowerTime + craneLiftTime + craneMoveTime);
+}
+
+double ExitSlotHeuristic::evaluate(const AStarState& state) const {
+    return std::max(slotLateness(state), base.evaluate(state));
+}
+
+double ExitSlotHeuristic::slotLateness(const AStarState& state) const {
+    std::vector<int> releases;
+    std::vector<int> dues;
+    for (const Release& container : releaseTimes(state, craneMoveTime, craneLowerTime, craneLiftTime)) {
+        releases.push_back(container.release);
+        dues.push_back(container.dueTime);
+    }
+    return matchedSlotLateness(releases, dues, exitCycleTime);
+}
+
+std::vector<ExitSlotHeuristic::Release> ExitSlotHeuristic::releaseTimes(const AStarState& state, int craneMoveTime,
+                                                                        int craneLowerTime, int craneLiftTime) {
+    int exitStack = static_cast<int>(state.stacks.size()) - 1;
+    int now = state.current_time;
+    int position = state.crane.position;
+    auto held = state.crane.getHeldContainer();
+
+    std::vector<Release> containers;
+    if (held) {
+        containers.push_back({-1, 0, now + std::abs(exitStack - position) * craneMoveTime + craneLowerTime,
+                              held->getArrivalTime() + held->getDueIn()});
+    }
+
+    // A held container has to be put down somewhere before anything else is picked
+    int freeAt = held ? now + craneMoveTime + craneLowerTime + craneLiftTime : now;
+    int relocationTime = 2 * (craneLowerTime + craneLiftTime + craneMoveTime);
+    for (int s = 0; s < exitStack; s++) {
+        const auto& stack = state.stacks[s];
+        int reach = held ? 0 : std::abs(position - s) * craneMoveTime;
+        int fromTop = freeAt + reach + craneLowerTime + craneLiftTime +
+                      std::abs(exitStack - s) * craneMoveTime + craneLowerTime;
+        int height = static_cast<int>(stack.size());
+        for (int pos = 0; pos < height; pos++) {
+            if (stack[pos].getExitTime() != -1) {
+                continue;
+            }
+            containers.push_back({s, pos, fromTop + (height - pos - 1) * relocationTime,
+                                  stack[pos].getArrivalTime() + stack[pos].getDueIn()});
+        }
+    }
+    return containers;
+}
+
+double ExitSlotHeuristic::matchedSlotLateness(std::vector<int>& releases, std::vector<int>& dues, int exitCycleTime) {
+    std::sort(releases.begin(), releases.end());
+    std::sort(dues.begin(), dues.end());
+
+    double lateness = 0.0;
+    int slot = 0;
+    for (size_t k = 0; k < releases.size(); k++) {
+        slot = k == 0 ? releases[0] : std::max(slot + exitCycleTime, releases[k]);
+        lateness += std::max(0, slot - dues[k]);
+    }
+    return lateness;
+}
@@ -0,0 +1,201 @@
+#include "AStarSolver.h"
+#include "StateCopies.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <iostream>
+#include <set>
+#include <tuple>
+
+// Focal search (A*_eps). OPEN is ordered on the usual (f, time) key. FOCAL
+// holds the open nodes with f <= (1+eps) * f_min and is ordered on a cheap,
+// inadmissible estimate of how much digging is left: the number of
+// containers sitting above one that is due earlier. Expanding from FOCAL
+// drives the search towards tidy yards while f_min keeps the proof: the
+// first goal taken from FOCAL has lateness at most (1+eps) times the optimum.
+//
+// That proof needs OPEN to keep every state that can still do better, so
+// duplicates are handled as in StateCopies.h.
+//
+// Both sets need arbitrary removal (a node leaves OPEN when FOCAL expands it
+// and vice versa), so they are ordered sets rather than IOpenList heaps.
+
+namespace {
+
+struct FocalNode {
+    AStarState state;
+    int g;
+    int h;
+    int blocking;
+    uint32_t parent;
+    uint32_t nextCopy = NodeArena<FocalNode>::NONE;   // next live copy of the same state
+    bool superseded = false;                           // dropped for a copy that is no worse
+
+    FocalNode(AStarState s, int gCost, int hCost, int blockingCount, uint32_t p)
+        : state(std::move(s)), g(gCost), h(hCost), blocking(blockingCount), parent(p) {}
+
+    int f() const { return g + h; }
+    uint64_t key() const { return packSearchKey(g + h, state.current_time); }
+};
+
+// Unexited containers stacked above an unexited container that is due earlier
+int countBlockingContainers(const AStarState& state) {
+    int blocking = 0;
+    for (size_t stackIdx = 0; stackIdx + 1 < state.stacks.size(); stackIdx++) {
+        int earliestDueBelow = INT_MAX;
+        for (const auto& container : state.stacks[stackIdx]) {
+            if (container.getExitTime() != -1) {
+                continue;
+            }
+            int dueTime = container.getDueTime();
+            if (dueTime > earliestDueBelow) {
+                blocking++;
+            }
+            earliestDueBelow = std::min(earliestDueBelow, dueTime);
+        }
+    }
+    return blocking;
+}
+
+}
+
+AStarSolution AStarSolver::solveFocal(const AStarState& initialState) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    initialContainerCount = initialState.getUnexitedContainers();
+
+    nodesExpanded = 0;
+    nodesGenerated = 0;
+    duplicatesDetected = 0;
+    fingerprintCollisions = 0;
+    allSolutions.clear();
+
+    double epsilon = std::max(focalEpsilon, 0.0);
+    auto focalBound = [epsilon](int fMin) {
+        return static_cast<int>(std::floor((1.0 + epsilon) * fMin));
+    };
+
+    NodeArena<FocalNode> focalNodes;
+    // Keyed by StateCopies::key(): configuration ranks are only used by solve()
+    stateRanking.reset();
+    stateTable.setDenseStates(0);
+    stateTable.clear();
+    stateTable.reserve(std::min(static_cast<size_t>(std::max(maxNodes, 0)), MAX_PRESIZED_STATES));
+
+    std::set<std::pair<uint64_t, uint32_t>> openSet;
+    std::set<std::tuple<int, uint64_t, uint32_t>> focalSet;
+    int bound = INT_MIN;
+
+    auto insertOpen = [&](uint32_t index) {
+        const FocalNode& node = focalNodes[index];
+        openSet.emplace(node.key(), index);
+        if (node.f() <= bound) {
+            focalSet.emplace(node.blocking, node.key(), index);
+        }
+    };
+
+    AStarState root = initialState;
+    root.fingerprint = initialState.computeFingerprint();
+    int g0 = static_cast<int>(root.getTotalLateness());
+    int h0 = evaluateHeuristic(root);
+    int blocking0 = countBlockingContainers(root);
+    uint32_t rootIndex = focalNodes.emplace(std::move(root), g0, h0, blocking0, NodeArena<FocalNode>::NONE);
+    bool inserted;
+    StateTable::Entry& rootEntry = stateTable.findOrInsert(StateCopies::key(focalNodes[rootIndex].state), inserted);
+    rootEntry.node = rootIndex;
+    insertOpen(rootIndex);
+    nodesGenerated++;
+
+    if (verbose) {
+        std::cout << "\n=== Focal Search Started (eps = " << epsilon << ") ===" << std::endl;
+        std::cout << "Initial heuristic value: " << h0 << std::endl;
+        std::cout << "Max nodes limit: " << maxNodes << std::endl;
+    }
+
+    while (!openSet.empty() && nodesExpanded < maxNodes) {
+        // f_min only grows while the heuristic is consistent; when it does,
+        // widen FOCAL with the OPEN nodes that now fall under the bound.
+        // bound stays the widest bound FOCAL was filled to.
+        int fMin = searchKeyF(openSet.begin()->first);
+        int currentBound = focalBound(fMin);
+        if (currentBound > bound) {
+            auto it = openSet.lower_bound({packSearchKey(bound == INT_MIN ? 0 : bound + 1, 0), 0});
+            for (; it != openSet.end() && searchKeyF(it->first) <= currentBound; ++it) {
+                focalSet.emplace(focalNodes[it->second].blocking, it->first, it->second);
+            }
+            bound = currentBound;
+        }
+
+        // A node that entered FOCAL under an older, wider bound can outlive
+        // a drop in f_min; those are left for OPEN to expand
+        auto focalIt = focalSet.begin();
+        uint32_t currentIndex;
+        if (focalIt != focalSet.end() && searchKeyF(std::get<1>(*focalIt)) <= currentBound) {
+            currentIndex = std::get<2>(*focalIt);
+            openSet.erase({std::get<1>(*focalIt), currentIndex});
+            focalSet.erase(focalIt);
+        } else {
+            auto openIt = openSet.begin();
+            currentIndex = openIt->second;
+            focalSet.erase({focalNodes[currentIndex].blocking, openIt->first, currentIndex});
+            openSet.erase(openIt);
+        }
+        const FocalNode& current = focalNodes[currentIndex];
+        if (current.superseded) {
+            duplicatesDetected++;
+            continue;
+        }
+
+        if (current.state.isGoalState()) {
+            std::vector<AStarState> path;
+            for (uint32_t i = currentIndex; i != NodeArena<FocalNode>::NONE; i = focalNodes[i].parent) {
+                path.push_back(focalNodes[i].state);
+            }
+            std::reverse(path.begin(), path.end());
+            CompleteSolution completeSol = makeCompleteSolution(std::move(path), current.g);
+            completeSol.suboptimalityBound = 1.0 + epsilon;
+            if (current.g <= fMin) {
+                completeSol.suboptimalityBound = 1.0;
+            } else if (fMin > 0) {
+                completeSol.suboptimalityBound = std::min(completeSol.suboptimalityBound,
+                                                          static_cast<double>(current.g) / fMin);
+            }
+            publishSolution(completeSol);
+
+            if (verbose) {
+                std::cout << "Focal search found lateness " << current.g
+                          << " within " << completeSol.suboptimalityBound << "x of optimal" << std::endl;
+            }
+            break;
+        }
+
+        nodesExpanded++;
+
+        auto successors = generator->generateSuccessors(current.state);
+        for (auto& successor : successors) {
+            AStarState& nextState = successor.first;
+            int g = static_cast<int>(nextState.getTotalLateness());
+
+            StateTable::Entry& nextEntry = stateTable.findOrInsert(StateCopies::key(nextState), inserted);
+            if (inserted) {
+                nextEntry.node = NodeArena<FocalNode>::NONE;
+            }
+
+            if (!StateCopies::admit(focalNodes, nextEntry.node, g, nextState, [](FocalNode&) {})) {
+                duplicatesDetected++;
+                continue;
+            }
+
+            int h = evaluateHeuristic(nextState);
+            int blocking = countBlockingContainers(nextState);
+            uint32_t nextIndex = focalNodes.emplace(std::move(nextState), g, h, blocking, currentIndex);
+            focalNodes[nextIndex].nextCopy = nextEntry.node;
+            nextEntry.node = nextIndex;
+            insertOpen(nextIndex);
+            nodesGenerated++;
+        }
+    }
+
+    peakNodeBytes = focalNodes.peakSize() * sizeof(FocalNode);
+
+    return finishSearch(startTime);
+}
@@ -0,0 +1,79 @@
+#include "HeuristicRegistry.h"
+#include "BlockingHeuristic.h"
+#include "ExitSlotHeuristic.h"
+#include "LatenessHeuristic.h"
+#include "LearnedHeuristic.h"
+#include "MaxHeuristic.h"
+#include "PatternDatabaseHeuristic.h"
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+HeuristicRegistry::HeuristicRegistry() {
+    add("lateness", "per-container exit time with flat relocation cost (default)",
+        [](const ParsedBuffers& buffers) { return std::make_unique<LatenessHeuristic>(buffers); });
+    add("exit-slot", "exit slots one crane cycle apart, matched to due times",
+        [](const ParsedBuffers& buffers) { return std::make_unique<ExitSlotHeuristic>(buffers); });
+    add("blocking", "exit slots plus put-downs forced by blocking containers",
+        [](const ParsedBuffers& buffers) { return std::make_unique<BlockingHeuristic>(buffers); });
+    add("pdb", "pairwise pattern database, cached in the working directory",
+        [](const ParsedBuffers& buffers) { return std::make_unique<PatternDatabaseHeuristic>(buffers); });
+    add("learned", "offline-trained linear model, inadmissible, for large yards",
+        [](const ParsedBuffers& buffers) { return std::make_unique<LearnedHeuristic>(buffers); });
+}
+
+HeuristicRegistry& HeuristicRegistry::instance() {
+    static HeuristicRegistry registry;
+    return registry;
+}
+
+void HeuristicRegistry::add(const std::string& name, const std::string& description, Factory factory) {
+    for (auto& registration : registrations) {
+        if (registration.name == name) {
+            registration = {name, description, std::move(factory)};
+            return;
+        }
+    }
+    registrations.push_back({name, description, std::move(factory)});
+}
+
+bool HeuristicRegistry::contains(const std::string& name) const {
+    return find(name) != nullptr;
+}
+
+const HeuristicRegistry::Registration* HeuristicRegistry::find(const std::string& name) const {
+    for (const auto& registration : registrations) {
+        if (registration.name == name) {
+            return &registration;
+        }
+    }
+    return nullptr;
+}
+
+std::unique_ptr<IHeuristic> HeuristicRegistry::create(const std::string& specification,
+                                                      const ParsedBuffers& buffers) const {
+    std::vector<std::unique_ptr<IHeuristic>> components;
+    std::stringstream names(specification);
+    std::string name;
+    while (std::getline(names, name, ',')) {
+        const Registration* registration = find(name);
+        if (!registration) {
+            throw std::invalid_argument("Unknown heuristic: " + name);
+        }
+        components.push_back(registration->factory(buffers));
+    }
+
+    if (components.empty()) {
+        throw std::invalid_argument("Empty heuristic specification");
+    }
+    if (components.size() == 1) {
+        return std::move(components.front());
+    }
+    return std::make_unique<MaxHeuristic>(std::move(components));
+}
+
+void HeuristicRegistry::printAvailable(std::ostream& out) const {
+    for (const auto& registration : registrations) {
+        out << "  " << registration.name << " - " << registration.description << std::endl;
+    }
+}
@@ -0,0 +1,120 @@
+#include "HeuristicTelemetry.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+void HeuristicTelemetry::reset() {
+    calls = 0;
+    evaluations = 0;
+    timedEvaluations = 0;
+    timedNanoseconds = 0;
+    expansionsPerF.clear();
+    solutionPath.clear();
+}
+
+void HeuristicTelemetry::recordSolutionPath(const std::vector<AStarState>& path, const IHeuristic& heuristic) {
+    solutionPath.clear();
+    if (path.empty()) {
+        return;
+    }
+    int total = static_cast<int>(path.back().getTotalLateness());
+    for (size_t i = 0; i < path.size(); i++) {
+        int g = static_cast<int>(path[i].getTotalLateness());
+        int h = static_cast<int>(std::floor(heuristic.evaluate(path[i])));
+        solutionPath.push_back({static_cast<int>(i), g, h, total - g});
+    }
+}
+
+double HeuristicTelemetry::getEvaluateSeconds() const {
+    uint64_t timed = timedEvaluations.load(std::memory_order_relaxed);
+    if (timed == 0) {
+        return 0.0;
+    }
+    double perEvaluation = timedNanoseconds.load(std::memory_order_relaxed) * 1e-9 / timed;
+    return perEvaluation * getEvaluations();
+}
+
+std::vector<uint64_t> HeuristicTelemetry::plateauHistogram() const {
+    std::vector<uint64_t> buckets;
+    for (const auto& [f, size] : expansionsPerF) {
+        size_t bucket = 0;
+        while ((uint64_t(2) << bucket) <= size) {
+            bucket++;
+        }
+        if (buckets.size() <= bucket) {
+            buckets.resize(bucket + 1, 0);
+        }
+        buckets[bucket]++;
+    }
+    return buckets;
+}
+
+void HeuristicTelemetry::printSummary(std::ostream& out) const {
+    uint64_t count = getEvaluations();
+    double seconds = getEvaluateSeconds();
+    out << "Heuristic evaluations: " << count << " (~" << std::fixed << std::setprecision(3) << seconds
+        << " s, " << std::setprecision(0) << (count ? seconds * 1e9 / count : 0.0) << " ns each)" << std::endl;
+
+    if (!expansionsPerF.empty()) {
+        uint64_t largest = 0;
+        for (const auto& entry : expansionsPerF) {
+            largest = std::max(largest, entry.second);
+        }
+        out << "f plateaus: " << expansionsPerF.size() << " distinct f values, largest "
+            << largest << " expansions" << std::endl;
+    }
+
+    int overestimates = 0;
+    double ratioSum = 0.0;
+    int ratioCount = 0;
+    for (const auto& point : solutionPath) {
+        overestimates += point.h > point.costToGo;
+        if (point.costToGo > 0) {
+            ratioSum += static_cast<double>(point.h) / point.costToGo;
+            ratioCount++;
+        }
+    }
+    if (!solutionPath.empty()) {
+        out << "Heuristic on solution path: mean h / cost-to-go " << std::setprecision(3)
+            << (ratioCount ? ratioSum / ratioCount : 1.0) << ", " << overestimates
+            << " overestimates in " << solutionPath.size() << " states" << std::endl;
+    }
+}
+
+void HeuristicTelemetry::writeReport(std::ostream& out, const std::string& heuristicName,
+                                     const std::string& searchMode) const {
+    uint64_t count = getEvaluations();
+    double seconds = getEvaluateSeconds();
+
+    out << "{\n";
+    out << "  \"heuristic\": \"" << heuristicName << "\",\n";
+    out << "  \"searchMode\": \"" << searchMode << "\",\n";
+    out << "  \"evaluations\": " << count << ",\n";
+    out << "  \"evaluateSeconds\": " << std::setprecision(6) << std::fixed << seconds << ",\n";
+    out << "  \"sampledEvaluations\": " << timedEvaluations.load() << ",\n";
+
+    out << "  \"fPlateaus\": {\n";
+    out << "    \"distinctF\": " << expansionsPerF.size() << ",\n";
+    out << "    \"sizeHistogram\": [";
+    std::vector<uint64_t> buckets = plateauHistogram();
+    for (size_t i = 0; i < buckets.size(); i++) {
+        out << (i ? ", " : "") << "{\"minSize\": " << (uint64_t(1) << i) << ", \"plateaus\": " << buckets[i] << "}";
+    }
+    out << "],\n";
+    out << "    \"expansionsPerF\": [";
+    std::vector<std::pair<int, uint64_t>> plateaus(expansionsPerF.begin(), expansionsPerF.end());
+    std::sort(plateaus.begin(), plateaus.end());
+    for (size_t i = 0; i < plateaus.size(); i++) {
+        out << (i ? ", " : "") << "[" << plateaus[i].first << ", " << plateaus[i].second << "]";
+    }
+    out << "]\n  },\n";
+
+    out << "  \"solutionPath\": [";
+    for (size_t i = 0; i < solutionPath.size(); i++) {
+        const PathPoint& point = solutionPath[i];
+        out << (i ? "," : "") << "\n    {\"step\": " << point.step << ", \"g\": " << point.g
+            << ", \"h\": " << point.h << ", \"costToGo\": " << point.costToGo << "}";
+    }
+    out << (solutionPath.empty() ? "]\n" : "\n  ]\n");
+    out << "}\n";
+}
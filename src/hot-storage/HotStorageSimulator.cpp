@@ -14,6 +14,10 @@
 #include "AStarStartingState.h"
 
 
+// How long a replan may keep improving its first plan, in seconds. Finding
+// that plan is only bounded by the solver's node limit.
+static constexpr double REPLAN_TIME_LIMIT = 2.0;
+
 HotStorageSimulator::HotStorageSimulator(Printer &p) : printer(&p) {
     needsRecalculation = false;
     systemPaused = false;
@@ -166,10 +170,11 @@ std::vector<std::string> HotStorageSimulator::recalculateAStar() {
     
         std::cout << "\n--- TESTING WAIT ACTION ---" << std::endl;
     AStarState waitState = currentState;
-    waitState.current_time += 10;     waitState.lastAction = "Waited for 10 seconds";
+    waitState.current_time += 10;     waitState.lastAction.kind = LastAction::WAIT;
+    waitState.lastAction.waitTime = 10;
     
         for (size_t i = 0; i < waitState.stacks.size(); i++) {
-        for (auto& container : waitState.stacks[i]) {
+        for (const auto& container : waitState.stacks[i]) {
             if (container.getExitTime() == -1 && i == waitState.stacks.size() - 1) {
                                 int dueTime = container.getArrivalTime() + container.getDueIn();
                 if (waitState.current_time >= dueTime + 60) {                     std::cout << "Container " << container.getId() 
@@ -180,7 +185,16 @@ std::vector<std::string> HotStorageSimulator::recalculateAStar() {
     }
     
         std::cout << "\n--- RUNNING A* WITH DEBUGGING ---" << std::endl;
-    AStarSolver solver(*data, 1000000, false, 1);     AStarSolution solution = solver.solve(currentState);
+    // The yard stays paused while planning, so replan anytime: take the
+    // first weighted plan quickly and keep tightening it until the budget runs out
+    AStarSolver solver(*data, 1000000, false, 1);
+    solver.setSearchMode(SearchMode::ANYTIME_ARA);
+    solver.setAnytimeSchedule(3.0, 0.5, REPLAN_TIME_LIMIT);
+    solver.setSolutionCallback([](const CompleteSolution& plan) {
+        std::cout << "Plan improved: lateness " << plan.totalLateness
+                  << ", within " << plan.suboptimalityBound << "x of optimal" << std::endl;
+    });
+    AStarSolution solution = solver.solve(currentState);
     
     std::cout << "\n--- A* RESULTS ---" << std::endl;
     std::cout << "Solution found: " << (solution.found ? "YES" : "NO") << std::endl;
@@ -213,14 +227,16 @@ std::vector<std::string> HotStorageSimulator::recalculateAStar() {
                 
                 transformedMoves.push_back(std::to_string(sourceStack) + " " + std::to_string(destStack));
                 i++;             }
-            else if (bestMoves[i].find("Waited for 10 seconds") != std::string::npos) {
-                int waitCount = 1;
-                while (i + waitCount < bestMoves.size() && 
-                       bestMoves[i + waitCount].find("Waited for 10 seconds") != std::string::npos) {
-                    waitCount++;
+            else if (bestMoves[i].find("Waited for ") != std::string::npos) {
+                // Waits jump to the next event and can be any length; the
+                // crane sleeps in 10 second steps, rounded up
+                int waitSeconds = 0;
+                while (i < bestMoves.size() && bestMoves[i].find("Waited for ") != std::string::npos) {
+                    waitSeconds += std::stoi(bestMoves[i].substr(bestMoves[i].find("Waited for ") + 11));
+                    i++;
                 }
-                transformedMoves.push_back("101010 " + std::to_string(waitCount));
-                i += waitCount - 1;
+                i--;
+                transformedMoves.push_back("101010 " + std::to_string((waitSeconds + 9) / 10));
             }
         }
         }
@@ -474,14 +490,16 @@ void HotStorageSimulator::simulate(){
                 currentMoves.push_back(std::to_string(sourceStack) + " " + std::to_string(destStack));
                 i++;
             }
-            else if (bestMoves[i].find("Waited for 10 seconds") != std::string::npos) {
-                int waitCount = 1;
-                while (i + waitCount < bestMoves.size() && 
-                       bestMoves[i + waitCount].find("Waited for 10 seconds") != std::string::npos) {
-                    waitCount++;
+            else if (bestMoves[i].find("Waited for ") != std::string::npos) {
+                // Waits jump to the next event and can be any length; the
+                // crane sleeps in 10 second steps, rounded up
+                int waitSeconds = 0;
+                while (i < bestMoves.size() && bestMoves[i].find("Waited for ") != std::string::npos) {
+                    waitSeconds += std::stoi(bestMoves[i].substr(bestMoves[i].find("Waited for ") + 11));
+                    i++;
                 }
-                currentMoves.push_back("101010 " + std::to_string(waitCount));
-                i += waitCount - 1;
+                i--;
+                currentMoves.push_back("101010 " + std::to_string((waitSeconds + 9) / 10));
             }
         }
         
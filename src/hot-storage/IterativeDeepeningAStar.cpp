@@ -0,0 +1,204 @@
+#include "AStarSolver.h"
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <limits>
+#include <map>
+
+// Iterative-deepening A*. Each iteration is a depth-first search that only
+// follows successors whose f stays within the current threshold. Memory is
+// the current path plus its unvisited siblings instead of one stored state
+// per generated node.
+//
+// Lateness takes almost every integer value, so raising the threshold to the
+// smallest cut-off f would run one iteration per unit of lateness. Instead
+// the cut-off f values are counted and the next threshold is set so that
+// about as many cut-off nodes fall under it as the iteration expanded, which
+// roughly doubles the work per iteration (IDA*_CR). Overshooting the optimum
+// is harmless because the final iteration is a branch and bound.
+//
+// The transposition table is the solver's StateTable and lives for one
+// iteration: a state reached again with no better (g, time) key explores a
+// subset of what was already explored, so it is skipped. When a memory
+// budget is set the table stops taking new entries once full and the search
+// falls back to plain IDA* for the states it cannot record.
+//
+// The iteration that finds a goal is finished as a branch and bound, so the
+// result is the best (lateness, finish time) goal, the same order solve()
+// uses for its first solution.
+
+namespace {
+
+struct IdaChild {
+    uint64_t key;
+    int g;
+    AStarState state;
+};
+
+struct IdaFrame {
+    AStarState state;
+    int g;
+    std::vector<IdaChild> children;
+    size_t next;
+};
+
+// Worst-case slots per entry: the table keeps its load under 0.7 and doubles when it grows
+constexpr size_t TABLE_SLOTS_PER_ENTRY = 3;
+
+}
+
+AStarSolution AStarSolver::solveIterativeDeepening(const AStarState& initialState) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    initialContainerCount = initialState.getUnexitedContainers();
+
+    nodesExpanded = 0;
+    nodesGenerated = 0;
+    duplicatesDetected = 0;
+    fingerprintCollisions = 0;
+    peakNodeBytes = 0;
+    allSolutions.clear();
+
+    size_t maxTableEntries = memoryBudgetBytes > 0
+        ? memoryBudgetBytes / (TABLE_SLOTS_PER_ENTRY * sizeof(StateTable::Entry))
+        : std::numeric_limits<size_t>::max();
+
+    AStarState root = initialState;
+    root.fingerprint = initialState.computeFingerprint();
+    int g0 = static_cast<int>(root.getTotalLateness());
+    int threshold = g0 + evaluateHeuristic(root);
+    nodesGenerated++;
+
+    if (verbose) {
+        std::cout << "\n=== IDA* Search Started ===" << std::endl;
+        std::cout << "Initial threshold: " << threshold << std::endl;
+        std::cout << "Max nodes limit: " << maxNodes << std::endl;
+        if (memoryBudgetBytes > 0) {
+            std::cout << "Transposition table budget: " << memoryBudgetBytes / 1024 << " KB" << std::endl;
+        }
+    }
+
+    uint64_t incumbentKey = std::numeric_limits<uint64_t>::max();
+    std::vector<AStarState> incumbentPath;
+    int incumbentG = 0;
+    size_t peakStoredStates = 0;
+    int iteration = 0;
+    // Keyed by fingerprint: configuration ranks are only used by solve()
+    stateRanking.reset();
+    stateTable.setDenseStates(0);
+
+    while (incumbentPath.empty() && threshold != INT_MAX && nodesExpanded < maxNodes) {
+        iteration++;
+        int expandedBefore = nodesExpanded;
+        std::map<int, size_t> cutoffs;
+        stateTable.clear();
+
+        std::vector<IdaFrame> stack;
+        size_t storedStates = 0;
+
+        // Pushes a state onto the path: records goals, otherwise expands it
+        auto enter = [&](AStarState state, int g) {
+            if (state.isGoalState()) {
+                uint64_t goalKey = packSearchKey(g, state.current_time);
+                if (goalKey < incumbentKey) {
+                    incumbentKey = goalKey;
+                    incumbentG = g;
+                    incumbentPath.clear();
+                    for (const IdaFrame& frame : stack) {
+                        incumbentPath.push_back(frame.state);
+                    }
+                    incumbentPath.push_back(std::move(state));
+                    if (verbose) {
+                        std::cout << "Solution found in iteration " << iteration
+                                  << ", lateness " << g << std::endl;
+                    }
+                }
+                return;
+            }
+
+            nodesExpanded++;
+            IdaFrame frame{std::move(state), g, {}, 0};
+            for (auto& successor : generator->generateSuccessors(frame.state)) {
+                AStarState& next = successor.first;
+                int childG = static_cast<int>(next.getTotalLateness());
+                int f = childG + evaluateHeuristic(next);
+                if (f > threshold) {
+                    cutoffs[f]++;
+                    continue;
+                }
+                uint64_t key = packSearchKey(f, next.current_time);
+                if (key >= incumbentKey) {
+                    continue;
+                }
+                frame.children.push_back({key, childG, std::move(next)});
+                nodesGenerated++;
+            }
+            std::sort(frame.children.begin(), frame.children.end(),
+                [](const IdaChild& a, const IdaChild& b) { return a.key < b.key; });
+
+            storedStates += frame.children.size() + 1;
+            peakStoredStates = std::max(peakStoredStates, storedStates);
+            stack.push_back(std::move(frame));
+        };
+
+        // Returns false when the state was already explored with an equal or better key
+        auto admit = [&](const AStarState& state, int g) {
+            uint64_t gKey = packSearchKey(g, state.current_time);
+            StateTable::Entry* entry = stateTable.find(state.fingerprint);
+            if (!entry && stateTable.size() < maxTableEntries) {
+                bool inserted;
+                entry = &stateTable.findOrInsert(state.fingerprint, inserted);
+            }
+            if (entry) {
+                if (entry->bestG <= gKey) {
+                    duplicatesDetected++;
+                    return false;
+                }
+                entry->bestG = gKey;
+            }
+            return true;
+        };
+
+        admit(root, g0);
+        enter(root, g0);
+
+        while (!stack.empty() && nodesExpanded < maxNodes) {
+            IdaFrame& top = stack.back();
+            if (top.next == top.children.size()) {
+                storedStates -= top.children.size() + 1;
+                stack.pop_back();
+                continue;
+            }
+
+            IdaChild& child = top.children[top.next++];
+            // The incumbent may have improved since this child was generated
+            if (child.key >= incumbentKey || !admit(child.state, child.g)) {
+                continue;
+            }
+            enter(std::move(child.state), child.g);
+        }
+
+        if (verbose) {
+            std::cout << "Iteration " << iteration << " (threshold " << threshold << "): "
+                      << nodesExpanded << " expanded, " << stateTable.size()
+                      << " transpositions" << std::endl;
+        }
+        threshold = INT_MAX;
+        size_t target = std::max(nodesExpanded - expandedBefore, 1);
+        size_t covered = 0;
+        for (const auto& [f, count] : cutoffs) {
+            threshold = f;
+            covered += count;
+            if (covered >= target) {
+                break;
+            }
+        }
+    }
+
+    peakNodeBytes = peakStoredStates * sizeof(AStarState);
+
+    if (!incumbentPath.empty()) {
+        publishSolution(makeCompleteSolution(std::move(incumbentPath), incumbentG));
+    }
+
+    return finishSearch(startTime);
+}
@@ -3,6 +3,50 @@
 #include <cmath>
 #include <iostream>
 
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Sum of max(0, ready[i] - slack[i]) over n containers
+long long sumLateness(const int* ready, const int* slack, size_t n) {
+    size_t i = 0;
+    long long total = 0;
+#if defined(__AVX2__)
+    __m256i acc = _mm256_setzero_si256();
+    for (; i + 8 <= n; i += 8) {
+        __m256i diff = _mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ready + i)),
+                                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(slack + i)));
+        acc = _mm256_add_epi32(acc, _mm256_max_epi32(diff, _mm256_setzero_si256()));
+    }
+    alignas(32) int lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    for (int lane : lanes) {
+        total += lane;
+    }
+#elif defined(__SSE2__)
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 4 <= n; i += 4) {
+        __m128i diff = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ready + i)),
+                                     _mm_loadu_si128(reinterpret_cast<const __m128i*>(slack + i)));
+        // SSE2 has no signed 32-bit max; mask off the non-positive lanes instead
+        acc = _mm_add_epi32(acc, _mm_and_si128(diff, _mm_cmpgt_epi32(diff, _mm_setzero_si128())));
+    }
+    alignas(16) int lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    for (int lane : lanes) {
+        total += lane;
+    }
+#endif
+    for (; i < n; i++) {
+        total += std::max(0, ready[i] - slack[i]);
+    }
+    return total;
+}
+
+}
+
 LatenessHeuristic::LatenessHeuristic(const ParsedBuffers& buffers) {
     UntilDue moveTime = buffers.getCraneMove();
     craneMoveTime = moveTime.getMinutes() * 60 + moveTime.getSeconds();
@@ -29,13 +73,69 @@ double LatenessHeuristic::evaluate(const AStarState& state) const {
     return calculateMinimumLateness(state);
 }
 
+void LatenessHeuristic::evaluateBatch(const AStarState* const* states, size_t count, double* values) const {
+    // Scratch arrays reused across calls; one set per search thread
+    thread_local std::vector<int> ready;
+    thread_local std::vector<int> slack;
+    thread_local std::vector<size_t> ends;
+    ready.clear();
+    slack.clear();
+    ends.clear();
+
+    int perContainerTime = 2 * (craneLowerTime + craneLiftTime + craneMoveTime);
+    for (size_t k = 0; k < count; k++) {
+        const AStarState& state = *states[k];
+        int outgoingStackIndex = state.stacks.size() - 1;
+        int heldOffset = state.crane.hasContainer
+            ? getMinMovesBetweenStacks(state.crane.position, outgoingStackIndex) * craneMoveTime + craneLowerTime
+            : 0;
+
+        for (int s = 0; s < outgoingStackIndex; s++) {
+            const auto& stack = state.stacks[s];
+            int reach = (!state.crane.hasContainer && state.crane.position != s)
+                ? getMinMovesBetweenStacks(state.crane.position, s) * craneMoveTime
+                : 0;
+            // Like calculateMinimumLateness(), the entry stack does not wait for the held container
+            int readyTime = state.current_time + reach + (s > 0 ? heldOffset : 0);
+            int fromTop = craneLowerTime + craneLiftTime +
+                          getMinMovesBetweenStacks(s, outgoingStackIndex) * craneMoveTime + craneLowerTime;
+
+            for (size_t pos = 0; pos < stack.size(); pos++) {
+                const auto& container = stack[pos];
+                if (container.getExitTime() != -1) {
+                    continue;
+                }
+                int containersAbove = stack.size() - pos - 1;
+                ready.push_back(readyTime);
+                slack.push_back(container.getArrivalTime() + container.getDueIn() -
+                                fromTop - containersAbove * perContainerTime);
+            }
+        }
+        ends.push_back(ready.size());
+    }
+
+    size_t begin = 0;
+    for (size_t k = 0; k < count; k++) {
+        values[k] = static_cast<double>(sumLateness(ready.data() + begin, slack.data() + begin, ends[k] - begin));
+        begin = ends[k];
+
+        #ifdef DEBUG
+        if (values[k] != calculateMinimumLateness(*states[k])) {
+            std::cerr << "[ERROR] Batched heuristic " << values[k] << " differs from full evaluation "
+                      << calculateMinimumLateness(*states[k]) << " after: " << states[k]->lastAction << std::endl;
+            abort();
+        }
+        #endif
+    }
+}
+
 double LatenessHeuristic::calculateMinimumLateness(const AStarState& state) const {
     double totalLateness = 0.0;
     
         if (state.crane.hasContainer) {
                 for (const auto& stack : state.stacks) {
             for (const auto& container : stack) {
-                if (container.getId() == state.crane.containerId && 
+                if (container.getIndex() == state.crane.heldContainer && 
                     container.getExitTime() == -1) {
                     
                                         int outgoingStackIndex = state.stacks.size() - 1;
@@ -154,4 +254,107 @@ int LatenessHeuristic::calculateMinTimeToExit(const AStarState& state,
 
 int LatenessHeuristic::getMinMovesBetweenStacks(int from, int to) const {
     return std::abs(to - from);
-}
\ No newline at end of file
+}
+double LatenessHeuristic::evaluate(const AStarState& state, Terms& terms) const {
+    int exitStack = static_cast<int>(state.stacks.size()) - 1;
+    terms.assign(exitStack + 1, 0);
+    for (int s = 0; s < exitStack; s++) {
+        terms[s] = static_cast<int>(terms.size());
+        appendStackSlacks(state, s, terms);
+    }
+    terms[exitStack] = static_cast<int>(terms.size());
+    return sumTerms(state, terms);
+}
+
+double LatenessHeuristic::evaluateIncremental(const AStarState& child, const Action& action,
+                                              const Terms& parentTerms, Terms& childTerms) const {
+    int exitStack = static_cast<int>(child.stacks.size()) - 1;
+    if (action.type == Action::RELOCATE) {
+        // Source and target stacks are rebuilt, the rest copied
+        childTerms.assign(exitStack + 1, 0);
+        childTerms.reserve(parentTerms.size());
+        for (int s = 0; s < exitStack; s++) {
+            childTerms[s] = static_cast<int>(childTerms.size());
+            if (s == action.sourceStack || s == action.targetStack) {
+                appendStackSlacks(child, s, childTerms);
+            } else {
+                childTerms.insert(childTerms.end(), parentTerms.begin() + parentTerms[s],
+                                  parentTerms.begin() + parentTerms[s + 1]);
+            }
+        }
+        childTerms[exitStack] = static_cast<int>(childTerms.size());
+    } else if (action.type == Action::WAIT || action.targetStack >= exitStack) {
+        childTerms = parentTerms;
+    } else {
+        // Untouched stacks are copied as they are, the target stack is rebuilt
+        int target = action.targetStack;
+        childTerms.clear();
+        childTerms.reserve(parentTerms.size() + 1);
+        childTerms.assign(parentTerms.begin(), parentTerms.begin() + exitStack + 1);
+        childTerms.insert(childTerms.end(), parentTerms.begin() + parentTerms[0],
+                          parentTerms.begin() + parentTerms[target]);
+        int rebuiltStart = static_cast<int>(childTerms.size());
+        appendStackSlacks(child, target, childTerms);
+        int shift = static_cast<int>(childTerms.size()) - rebuiltStart -
+                    (parentTerms[target + 1] - parentTerms[target]);
+        childTerms.insert(childTerms.end(), parentTerms.begin() + parentTerms[target + 1], parentTerms.end());
+        for (int s = target + 1; s <= exitStack; s++) {
+            childTerms[s] += shift;
+        }
+    }
+    double h = sumTerms(child, childTerms);
+
+    #ifdef DEBUG
+    double full = calculateMinimumLateness(child);
+    if (h != full) {
+        std::cerr << "[ERROR] Incremental heuristic " << h << " differs from full evaluation "
+                  << full << " after: " << child.lastAction << std::endl;
+        abort();
+    }
+    #endif
+
+    return h;
+}
+
+void LatenessHeuristic::appendStackSlacks(const AStarState& state, int stackIndex, Terms& terms) const {
+    // calculateMinTimeToExit() without the crane's reach, which sumTerms() adds per stack
+    int outgoingStackIndex = state.stacks.size() - 1;
+    int perContainerTime = 2 * (craneLowerTime + craneLiftTime + craneMoveTime);
+    int fromTop = craneLowerTime + craneLiftTime +
+                  getMinMovesBetweenStacks(stackIndex, outgoingStackIndex) * craneMoveTime + craneLowerTime;
+
+    size_t first = terms.size();
+    const auto& stack = state.stacks[stackIndex];
+    for (size_t pos = 0; pos < stack.size(); pos++) {
+        const auto& container = stack[pos];
+        if (container.getExitTime() != -1) {
+            continue;
+        }
+        int containersAbove = stack.size() - pos - 1;
+        int dueTime = container.getArrivalTime() + container.getDueIn();
+        terms.push_back(dueTime - fromTop - containersAbove * perContainerTime);
+    }
+    std::sort(terms.begin() + first, terms.end());
+}
+
+double LatenessHeuristic::sumTerms(const AStarState& state, const Terms& terms) const {
+    int outgoingStackIndex = state.stacks.size() - 1;
+    int heldOffset = state.crane.hasContainer
+        ? getMinMovesBetweenStacks(state.crane.position, outgoingStackIndex) * craneMoveTime + craneLowerTime
+        : 0;
+
+    long long totalLateness = 0;
+    for (int s = 0; s < outgoingStackIndex; s++) {
+        int reach = (!state.crane.hasContainer && state.crane.position != s)
+            ? getMinMovesBetweenStacks(state.crane.position, s) * craneMoveTime
+            : 0;
+        // Like calculateMinimumLateness(), the entry stack does not wait for the held container
+        int readyTime = state.current_time + reach + (s > 0 ? heldOffset : 0);
+
+        // Slacks are ascending, so the late containers come first
+        for (int i = terms[s]; i < terms[s + 1] && terms[i] < readyTime; i++) {
+            totalLateness += readyTime - terms[i];
+        }
+    }
+    return static_cast<double>(totalLateness);
+}
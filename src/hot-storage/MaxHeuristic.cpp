@@ -0,0 +1,65 @@
+#include "MaxHeuristic.h"
+#include <iomanip>
+#include <iostream>
+
+MaxHeuristic::MaxHeuristic(std::vector<std::unique_ptr<IHeuristic>> components)
+    : components(std::move(components)), dropAfter(5000), dropShare(0.01) {
+    stats.reset(new ComponentStats[this->components.size()]);
+}
+
+double MaxHeuristic::evaluate(const AStarState& state) const {
+    double best = 0.0;
+    size_t winner = components.size();
+    for (size_t i = 0; i < components.size(); i++) {
+        if (!stats[i].active.load(std::memory_order_relaxed)) {
+            continue;
+        }
+        double value = components[i]->evaluate(state);
+        uint64_t evaluations = stats[i].evaluations.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (winner == components.size() || value > best) {
+            best = value;
+            winner = i;
+        }
+        if (evaluations == dropAfter) {
+            reviewComponent(i, evaluations);
+        }
+    }
+    if (winner < components.size()) {
+        stats[winner].wins.fetch_add(1, std::memory_order_relaxed);
+    }
+    return best;
+}
+
+void MaxHeuristic::reviewComponent(size_t component, uint64_t evaluations) const {
+    if (component == 0) {
+        return;
+    }
+    uint64_t wins = stats[component].wins.load(std::memory_order_relaxed);
+    if (wins < dropShare * evaluations) {
+        stats[component].active.store(false, std::memory_order_relaxed);
+        #ifdef DEBUG
+        std::cout << "MaxHeuristic: dropping " << components[component]->getName()
+                  << " after " << wins << " wins in " << evaluations << " evaluations" << std::endl;
+        #endif
+    }
+}
+
+std::string MaxHeuristic::getName() const {
+    std::string name = "Max(";
+    for (size_t i = 0; i < components.size(); i++) {
+        name += (i ? ", " : "") + components[i]->getName();
+    }
+    return name + ")";
+}
+
+void MaxHeuristic::printStatistics() const {
+    for (size_t i = 0; i < components.size(); i++) {
+        uint64_t evaluations = stats[i].evaluations.load();
+        uint64_t wins = stats[i].wins.load();
+        std::cout << "  " << components[i]->getName() << ": " << evaluations << " evaluations, "
+                  << wins << " maxima (" << std::fixed << std::setprecision(1)
+                  << (evaluations ? 100.0 * wins / evaluations : 0.0) << "%)"
+                  << (stats[i].active.load() ? "" : ", dropped") << std::endl;
+        components[i]->printStatistics();
+    }
+}
@@ -0,0 +1,128 @@
+#include "OpenList.h"
+
+void DaryHeapOpenList::push(uint64_t key, uint32_t node) {
+    heap.emplace_back(key, node);
+    size_t i = heap.size() - 1;
+    auto item = heap[i];
+    while (i > 0) {
+        size_t parent = (i - 1) / ARITY;
+        if (heap[parent].first <= item.first) {
+            break;
+        }
+        heap[i] = heap[parent];
+        i = parent;
+    }
+    heap[i] = item;
+}
+
+uint32_t DaryHeapOpenList::pop() {
+    uint32_t result = heap.front().second;
+    auto item = heap.back();
+    heap.pop_back();
+    if (heap.empty()) {
+        return result;
+    }
+
+    size_t i = 0;
+    size_t n = heap.size();
+    while (true) {
+        size_t first = i * ARITY + 1;
+        if (first >= n) {
+            break;
+        }
+        size_t best = first;
+        size_t end = first + ARITY < n ? first + ARITY : n;
+        for (size_t c = first + 1; c < end; c++) {
+            if (heap[c].first < heap[best].first) {
+                best = c;
+            }
+        }
+        if (item.first <= heap[best].first) {
+            break;
+        }
+        heap[i] = heap[best];
+        i = best;
+    }
+    heap[i] = item;
+    return result;
+}
+
+RadixHeapOpenList::RadixHeapOpenList() : last(0), count(0), nonMonotonePushes(0) {}
+
+int RadixHeapOpenList::bucketFor(uint64_t key, uint64_t last) {
+    uint64_t diff = key ^ last;
+    return diff == 0 ? 0 : 64 - __builtin_clzll(diff);
+}
+
+void RadixHeapOpenList::push(uint64_t key, uint32_t node) {
+    count++;
+    if (key < last) {
+        nonMonotonePushes++;
+        belowLast.push(key, node);
+        return;
+    }
+    buckets[bucketFor(key, last)].emplace_back(key, node);
+}
+
+void RadixHeapOpenList::refill() {
+    if (!buckets[0].empty()) {
+        return;
+    }
+
+    int i = 1;
+    while (buckets[i].empty()) {
+        i++;
+    }
+
+    uint64_t newLast = buckets[i].front().first;
+    for (const auto& item : buckets[i]) {
+        if (item.first < newLast) {
+            newLast = item.first;
+        }
+    }
+    last = newLast;
+
+    for (const auto& item : buckets[i]) {
+        buckets[bucketFor(item.first, last)].push_back(item);
+    }
+    buckets[i].clear();
+}
+
+uint64_t RadixHeapOpenList::topKey() {
+    if (!belowLast.empty()) {
+        return belowLast.topKey();
+    }
+    refill();
+    return buckets[0].back().first;
+}
+
+uint32_t RadixHeapOpenList::pop() {
+    count--;
+    if (!belowLast.empty()) {
+        return belowLast.pop();
+    }
+    refill();
+    uint32_t node = buckets[0].back().second;
+    buckets[0].pop_back();
+    return node;
+}
+
+void RadixHeapOpenList::clear() {
+    for (auto& bucket : buckets) {
+        bucket.clear();
+    }
+    belowLast.clear();
+    last = 0;
+    count = 0;
+    nonMonotonePushes = 0;
+}
+
+std::unique_ptr<IOpenList> makeOpenList(OpenListType type) {
+    switch (type) {
+        case OpenListType::DARY_HEAP:
+            return std::make_unique<DaryHeapOpenList>();
+        case OpenListType::RADIX_HEAP:
+        default:
+            return std::make_unique<RadixHeapOpenList>();
+    }
+}
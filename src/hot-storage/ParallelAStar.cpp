@@ -0,0 +1,263 @@
+#include "AStarSolver.h"
+#include "MpscQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+// Hash-distributed A* (HDA*). Every state fingerprint has exactly one owning
+// worker, which keeps the only open list, state table and node arena that
+// may contain it. Successors owned by another worker are sent to that
+// worker's lock-free inbox, so duplicate detection never needs a lock.
+//
+// Termination: activeWork counts busy workers plus messages in flight. A
+// message is counted before it is enqueued, and a worker marks itself busy
+// before it releases the message it woke up for, so the counter can only
+// reach zero when no worker holds useful work and no message is pending.
+// Work is useful while its (f, time) key is below the incumbent's.
+//
+// Duplicates are handled as in solve(): a state is only queued again when it
+// is reached with a lower g, and it is expanded at most once. With one
+// worker the search is solve() with one solution. With more, workers expand
+// out of global key order and a state closed early is not reopened, so the
+// plan can differ from solve()'s.
+
+namespace {
+
+struct NodeRef {
+    uint32_t worker;
+    uint32_t index;
+};
+
+constexpr NodeRef NO_NODE = {UINT32_MAX, UINT32_MAX};
+
+struct HdaNode {
+    AStarState state;
+    int g;
+    int h;
+    NodeRef parent;
+
+    HdaNode(AStarState s, int gCost, int hCost, NodeRef p)
+        : state(std::move(s)), g(gCost), h(hCost), parent(p) {}
+
+    uint64_t key() const { return packSearchKey(g + h, state.current_time); }
+};
+
+struct HdaMessage {
+    AStarState state;
+    int g = 0;
+    NodeRef parent = NO_NODE;
+};
+
+struct HdaWorker {
+    NodeArena<HdaNode> nodes;
+    StateTable table;
+    std::unique_ptr<IOpenList> open;
+    MpscQueue<HdaMessage> inbox;
+
+    int expanded = 0;
+    int generated = 0;
+    int duplicates = 0;
+    int messagesSent = 0;
+};
+
+struct HdaShared {
+    std::vector<std::unique_ptr<HdaWorker>> workers;
+    std::atomic<long> activeWork{0};
+    std::atomic<bool> done{false};
+    std::atomic<int> expanded{0};
+
+    std::atomic<uint64_t> incumbentKey{std::numeric_limits<uint64_t>::max()};
+    std::mutex incumbentMutex;
+    NodeRef incumbent = NO_NODE;
+
+    uint32_t ownerOf(uint64_t fingerprint) const {
+        // The table hashes with the low bits multiplied through, so use the top bits here
+        return static_cast<uint32_t>((fingerprint >> 40) % workers.size());
+    }
+};
+
+}
+
+AStarSolution AStarSolver::solveParallel(const AStarState& initialState) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    initialContainerCount = initialState.getUnexitedContainers();
+
+    nodesExpanded = 0;
+    nodesGenerated = 0;
+    duplicatesDetected = 0;
+    fingerprintCollisions = 0;
+    allSolutions.clear();
+
+    unsigned workerCount = threadCount > 0 ? threadCount : std::thread::hardware_concurrency();
+    if (workerCount == 0) {
+        workerCount = 1;
+    }
+
+    HdaShared shared;
+    size_t expectedPerWorker = std::min(static_cast<size_t>(std::max(maxNodes, 0)), MAX_PRESIZED_STATES) / workerCount;
+    for (unsigned i = 0; i < workerCount; i++) {
+        auto worker = std::make_unique<HdaWorker>();
+        worker->open = makeOpenList(openListType);
+        worker->table.reserve(expectedPerWorker);
+        shared.workers.push_back(std::move(worker));
+    }
+
+    if (verbose) {
+        std::cout << "\n=== HDA* Search Started ===" << std::endl;
+        std::cout << "Worker threads: " << workerCount << std::endl;
+        std::cout << "Max nodes limit: " << maxNodes << std::endl;
+    }
+
+    // Seed the owner of the initial state; it starts out busy with it
+    HdaMessage seed;
+    seed.state = initialState;
+    seed.state.fingerprint = initialState.computeFingerprint();
+    seed.g = static_cast<int>(initialState.getTotalLateness());
+    shared.activeWork.fetch_add(1);
+    shared.workers[shared.ownerOf(seed.state.fingerprint)]->inbox.push(std::move(seed));
+
+    auto runWorker = [&](uint32_t self) {
+        HdaWorker& me = *shared.workers[self];
+        bool busy = false;
+
+        auto admit = [&](HdaMessage& msg) {
+            uint64_t gKey = packSearchKey(msg.g, msg.state.current_time);
+            bool inserted;
+            StateTable::Entry& entry = me.table.findOrInsert(msg.state.fingerprint, inserted);
+            if (entry.bestG <= gKey) {
+                me.duplicates++;
+                return;
+            }
+            entry.bestG = gKey;
+
+            int h = evaluateHeuristic(msg.state);
+            if (packSearchKey(msg.g + h, msg.state.current_time) >= shared.incumbentKey.load(std::memory_order_relaxed)) {
+                return;
+            }
+            uint32_t index = me.nodes.emplace(std::move(msg.state), msg.g, h, msg.parent);
+            me.open->push(me.nodes[index].key(), index);
+            me.generated++;
+        };
+
+        while (!shared.done.load(std::memory_order_acquire)) {
+            HdaMessage msg;
+            bool received = false;
+            while (me.inbox.pop(msg)) {
+                if (!busy) {
+                    busy = true;
+                    shared.activeWork.fetch_add(1);
+                }
+                admit(msg);
+                received = true;
+                shared.activeWork.fetch_sub(1);
+            }
+
+            uint64_t bound = shared.incumbentKey.load(std::memory_order_acquire);
+            if (me.open->empty() || me.open->topKey() >= bound) {
+                if (busy) {
+                    busy = false;
+                    shared.activeWork.fetch_sub(1);
+                }
+                if (shared.activeWork.load(std::memory_order_acquire) == 0) {
+                    shared.done.store(true, std::memory_order_release);
+                    break;
+                }
+                if (!received) {
+                    std::this_thread::yield();
+                }
+                continue;
+            }
+
+            if (!busy) {
+                busy = true;
+                shared.activeWork.fetch_add(1);
+            }
+
+            uint32_t currentIndex = me.open->pop();
+            const HdaNode& current = me.nodes[currentIndex];
+
+            if (current.state.isGoalState()) {
+                uint64_t goalKey = packSearchKey(current.g, current.state.current_time);
+                std::lock_guard<std::mutex> lock(shared.incumbentMutex);
+                if (goalKey < shared.incumbentKey.load(std::memory_order_relaxed)) {
+                    shared.incumbentKey.store(goalKey, std::memory_order_release);
+                    shared.incumbent = {self, currentIndex};
+                }
+                continue;
+            }
+
+            StateTable::Entry* entry = me.table.find(current.state.fingerprint);
+            if (entry->closed) {
+                me.duplicates++;
+                continue;
+            }
+            entry->closed = true;
+
+            if (shared.expanded.fetch_add(1, std::memory_order_relaxed) >= maxNodes) {
+                shared.done.store(true, std::memory_order_release);
+                break;
+            }
+            me.expanded++;
+
+            auto successors = generator->generateSuccessors(current.state);
+            for (auto& successor : successors) {
+                HdaMessage child;
+                child.state = std::move(successor.first);
+                child.g = static_cast<int>(child.state.getTotalLateness());
+                child.parent = {self, currentIndex};
+
+                uint32_t owner = shared.ownerOf(child.state.fingerprint);
+                if (owner == self) {
+                    admit(child);
+                } else {
+                    shared.activeWork.fetch_add(1);
+                    shared.workers[owner]->inbox.push(std::move(child));
+                    me.messagesSent++;
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < workerCount; i++) {
+        threads.emplace_back(runWorker, i);
+    }
+    runWorker(0);
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    int messagesSent = 0;
+    size_t liveNodes = 0;
+    for (const auto& worker : shared.workers) {
+        nodesExpanded += worker->expanded;
+        nodesGenerated += worker->generated;
+        duplicatesDetected += worker->duplicates;
+        messagesSent += worker->messagesSent;
+        liveNodes += worker->nodes.peakSize();
+    }
+    peakNodeBytes = liveNodes * sizeof(HdaNode);
+
+    if (shared.incumbent.worker != NO_NODE.worker) {
+        std::vector<AStarState> path;
+        NodeRef ref = shared.incumbent;
+        while (ref.worker != NO_NODE.worker) {
+            const HdaNode& node = shared.workers[ref.worker]->nodes[ref.index];
+            path.push_back(node.state);
+            ref = node.parent;
+        }
+        std::reverse(path.begin(), path.end());
+        const HdaNode& goal = shared.workers[shared.incumbent.worker]->nodes[shared.incumbent.index];
+        publishSolution(makeCompleteSolution(std::move(path), goal.g));
+    }
+
+    if (verbose) {
+        std::cout << "HDA* finished: " << nodesExpanded << " expanded, "
+                  << messagesSent << " states sent between workers" << std::endl;
+    }
+
+    return finishSearch(startTime);
+}
@@ -0,0 +1,376 @@
+#include "PatternDatabaseHeuristic.h"
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <queue>
+
+namespace {
+
+// Pattern configuration bit layout
+constexpr int STACKS_SHIFT = 0;      // 4 bits: number of stacks including entry and exit
+constexpr int COUNT_SHIFT = 4;       // 2 bits: containers in the pattern
+constexpr int CRANE_SHIFT = 6;       // 4 bits: crane position
+constexpr int HOLD_SHIFT = 10;       // 2 bits: 0 empty, 1 another container, 2 + i pattern container i
+constexpr int ITEM_SHIFT[2] = {12, 22};      // 4 bits stack + 6 bits containers above, per item
+constexpr int BELOW_SHIFT = 32;      // 2 bits: 0 apart, 1 first below second, 2 second below first
+
+constexpr uint32_t CACHE_MAGIC = 0x48504442;      // "HPDB"
+constexpr uint32_t CACHE_VERSION = 1;
+
+// Safety net for the per-pattern search; a pattern that hits it gets the trivial bound
+constexpr size_t MAX_PATTERN_LABELS = 200000;
+
+uint64_t bits(uint64_t config, int shift, int width) {
+    return (config >> shift) & ((uint64_t(1) << width) - 1);
+}
+
+struct AbstractState {
+    int time;
+    std::array<int, 2> exit;
+    int crane;
+    int hold;
+    std::array<int, 2> where;
+    std::array<int, 2> above;
+    int below;
+
+    uint64_t key() const {
+        return uint64_t(crane) | uint64_t(hold) << 4 | uint64_t(where[0]) << 6 | uint64_t(above[0]) << 10 |
+               uint64_t(where[1]) << 16 | uint64_t(above[1]) << 20 | uint64_t(below) << 26;
+    }
+};
+
+bool labelDominates(const AbstractState& a, const AbstractState& b) {
+    return a.time <= b.time && a.exit[0] <= b.exit[0] && a.exit[1] <= b.exit[1];
+}
+
+}
+
+PatternDatabaseHeuristic::PatternDatabaseHeuristic(const ParsedBuffers& buffers, const std::string& cacheDirectory)
+    : base(buffers), dirty(false) {
+    craneMoveTime = base.getCraneMoveTime();
+    craneLowerTime = base.getCraneLowerTime();
+    craneLiftTime = base.getCraneLiftTime();
+    bufferSize = buffers.getBufferSize();
+
+    cachePath = cacheDirectory + "/pdb_m" + std::to_string(craneMoveTime) +
+                "_l" + std::to_string(craneLowerTime) +
+                "_u" + std::to_string(craneLiftTime) +
+                "_b" + std::to_string(bufferSize) + ".bin";
+    load();
+}
+
+PatternDatabaseHeuristic::~PatternDatabaseHeuristic() {
+    if (dirty) {
+        save();
+    }
+}
+
+double PatternDatabaseHeuristic::evaluate(const AStarState& state) const {
+    std::vector<PatternItem> items;
+    int exitStack = static_cast<int>(state.stacks.size()) - 1;
+    for (int s = 0; s < exitStack; s++) {
+        const auto& stack = state.stacks[s];
+        for (size_t pos = 0; pos < stack.size(); pos++) {
+            if (stack[pos].getExitTime() == -1) {
+                items.push_back({s, static_cast<int>(pos),
+                                 stack[pos].getArrivalTime() + stack[pos].getDueIn()});
+            }
+        }
+    }
+    if (auto held = state.crane.getHeldContainer()) {
+        items.push_back({HELD, 0, held->getArrivalTime() + held->getDueIn()});
+    }
+
+    // Neighbours in due order compete for the crane the most
+    std::sort(items.begin(), items.end(),
+        [](const PatternItem& a, const PatternItem& b) { return a.dueTime < b.dueTime; });
+
+    int now = state.current_time;
+    double total = 0.0;
+    for (size_t i = 0; i < items.size(); i += 2) {
+        int count = i + 1 < items.size() ? 2 : 1;
+        const OffsetSet& offsets = lookup(encodePattern(state, &items[i], count));
+
+        int best = INT_MAX;
+        for (const auto& [first, second] : offsets) {
+            int lateness = std::max(0, now + first - items[i].dueTime);
+            if (count == 2) {
+                lateness += std::max(0, now + second - items[i + 1].dueTime);
+            }
+            best = std::min(best, lateness);
+        }
+        total += best == INT_MAX ? 0 : best;
+    }
+
+    return std::max(total, base.evaluate(state));
+}
+
+uint64_t PatternDatabaseHeuristic::encodePattern(const AStarState& state, const PatternItem* items, int count) const {
+    uint64_t config = uint64_t(state.stacks.size()) << STACKS_SHIFT |
+                      uint64_t(count) << COUNT_SHIFT |
+                      uint64_t(state.crane.position) << CRANE_SHIFT;
+
+    int hold = state.crane.hasContainer ? 1 : 0;
+    int below = 0;
+    for (int i = 0; i < count; i++) {
+        const PatternItem& item = items[i];
+        int above = 0;
+        if (item.stack == HELD) {
+            hold = 2 + i;
+        } else {
+            int top = static_cast<int>(state.stacks[item.stack].size()) - 1;
+            above = top - item.height;
+            if (count == 2) {
+                const PatternItem& other = items[1 - i];
+                if (other.stack == item.stack && other.height > item.height) {
+                    // Only the containers between the two count for the lower one
+                    above = other.height - item.height - 1;
+                    below = i == 0 ? 1 : 2;
+                }
+            }
+        }
+        above = std::min(above, 63);
+        config |= uint64_t(item.stack) << ITEM_SHIFT[i] | uint64_t(above) << (ITEM_SHIFT[i] + 4);
+    }
+    config |= uint64_t(hold) << HOLD_SHIFT | uint64_t(below) << BELOW_SHIFT;
+    return config;
+}
+
+const PatternDatabaseHeuristic::OffsetSet& PatternDatabaseHeuristic::lookup(uint64_t config) const {
+    {
+        std::lock_guard<std::mutex> lock(tableMutex);
+        auto it = table.find(config);
+        if (it != table.end()) {
+            return it->second;
+        }
+    }
+
+    OffsetSet offsets = solvePattern(config);
+
+    std::lock_guard<std::mutex> lock(tableMutex);
+    dirty = true;
+    return table.emplace(config, std::move(offsets)).first->second;
+}
+
+PatternDatabaseHeuristic::OffsetSet PatternDatabaseHeuristic::solvePattern(uint64_t config) const {
+    int stackCount = static_cast<int>(bits(config, STACKS_SHIFT, 4));
+    int count = static_cast<int>(bits(config, COUNT_SHIFT, 2));
+    int exitStack = stackCount - 1;
+
+    AbstractState start;
+    start.time = 0;
+    start.exit = {0, 0};
+    start.crane = static_cast<int>(bits(config, CRANE_SHIFT, 4));
+    start.hold = static_cast<int>(bits(config, HOLD_SHIFT, 2));
+    start.below = static_cast<int>(bits(config, BELOW_SHIFT, 2));
+    for (int i = 0; i < 2; i++) {
+        start.where[i] = i < count ? static_cast<int>(bits(config, ITEM_SHIFT[i], 4)) : EXITED;
+        start.above[i] = i < count ? static_cast<int>(bits(config, ITEM_SHIFT[i] + 4, 6)) : 0;
+    }
+
+    // The pattern container at the top of stack s, or -1
+    auto topItem = [&](const AbstractState& st, int s) {
+        int found = -1;
+        for (int i = 0; i < count; i++) {
+            if (st.where[i] != s) {
+                continue;
+            }
+            bool covered = (st.below == 1 && i == 0) || (st.below == 2 && i == 1);
+            if (!covered) {
+                found = i;
+            }
+        }
+        return found;
+    };
+
+    OffsetSet results;
+    auto dominatedByResult = [&](const AbstractState& st) {
+        for (const auto& [first, second] : results) {
+            int bound0 = st.where[0] == EXITED ? st.exit[0] : st.time;
+            int bound1 = st.where[1] == EXITED ? st.exit[1] : st.time;
+            if (first <= bound0 && second <= bound1) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto later = [](const AbstractState& a, const AbstractState& b) { return a.time > b.time; };
+    std::priority_queue<AbstractState, std::vector<AbstractState>, decltype(later)> frontier(later);
+    std::unordered_map<uint64_t, std::vector<AbstractState>> labels;
+
+    auto push = [&](const AbstractState& st) {
+        auto& seen = labels[st.key()];
+        for (const auto& other : seen) {
+            if (labelDominates(other, st)) {
+                return;
+            }
+        }
+        seen.erase(std::remove_if(seen.begin(), seen.end(),
+                       [&](const AbstractState& other) { return labelDominates(st, other); }),
+                   seen.end());
+        seen.push_back(st);
+        frontier.push(st);
+    };
+
+    push(start);
+    size_t processed = 0;
+    while (!frontier.empty()) {
+        AbstractState current = frontier.top();
+        frontier.pop();
+        if (++processed > MAX_PATTERN_LABELS) {
+            return {{0, 0}};
+        }
+
+        if (current.where[0] == EXITED && current.where[1] == EXITED) {
+            std::pair<int, int> offsets = {current.exit[0], current.exit[1]};
+            bool dominated = false;
+            for (const auto& r : results) {
+                dominated = dominated || (r.first <= offsets.first && r.second <= offsets.second);
+            }
+            if (!dominated) {
+                results.erase(std::remove_if(results.begin(), results.end(),
+                                  [&](const std::pair<int, int>& r) {
+                                      return offsets.first <= r.first && offsets.second <= r.second;
+                                  }),
+                              results.end());
+                results.push_back(offsets);
+            }
+            continue;
+        }
+        if (dominatedByResult(current)) {
+            continue;
+        }
+
+        if (current.hold == 0) {
+            // Pick up: only stacks holding a pattern container matter
+            for (int s = 0; s < exitStack; s++) {
+                int top = topItem(current, s);
+                if (top < 0) {
+                    continue;
+                }
+                AbstractState next = current;
+                next.time += std::abs(current.crane - s) * craneMoveTime + craneLowerTime + craneLiftTime;
+                next.crane = s;
+                if (current.above[top] > 0) {
+                    next.above[top]--;
+                    next.hold = 1;
+                } else {
+                    next.where[top] = HELD;
+                    next.hold = 2 + top;
+                    next.below = 0;
+                }
+                push(next);
+            }
+            continue;
+        }
+
+        // Put down: never on the entry stack or where the crane already is
+        for (int s = 1; s < stackCount; s++) {
+            if (s == current.crane) {
+                continue;
+            }
+            AbstractState next = current;
+            int arrival = current.time + std::abs(current.crane - s) * craneMoveTime + craneLowerTime;
+            next.time = arrival + craneLiftTime;
+            next.crane = s;
+            next.hold = 0;
+
+            if (current.hold == 1) {
+                int top = s == exitStack ? -1 : topItem(current, s);
+                if (top >= 0) {
+                    if (current.above[top] >= bufferSize) {
+                        continue;
+                    }
+                    next.above[top]++;
+                }
+            } else {
+                int item = current.hold - 2;
+                if (s == exitStack) {
+                    next.where[item] = EXITED;
+                    next.exit[item] = arrival;
+                } else {
+                    int top = topItem(current, s);
+                    next.where[item] = s;
+                    next.above[item] = 0;
+                    if (top >= 0) {
+                        next.below = top == 0 ? 1 : 2;
+                    }
+                }
+            }
+            push(next);
+        }
+    }
+
+    if (results.empty()) {
+        results.push_back({0, 0});
+    }
+    return results;
+}
+
+size_t PatternDatabaseHeuristic::getPatternCount() const {
+    std::lock_guard<std::mutex> lock(tableMutex);
+    return table.size();
+}
+
+bool PatternDatabaseHeuristic::load() {
+    std::ifstream in(cachePath, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+
+    uint32_t magic = 0, version = 0;
+    uint64_t entries = 0;
+    in.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    in.read(reinterpret_cast<char*>(&entries), sizeof(entries));
+    if (!in || magic != CACHE_MAGIC || version != CACHE_VERSION) {
+        std::cerr << "Ignoring unreadable pattern database cache " << cachePath << std::endl;
+        return false;
+    }
+
+    std::unordered_map<uint64_t, OffsetSet> loaded;
+    loaded.reserve(entries);
+    for (uint64_t e = 0; e < entries; e++) {
+        uint64_t config = 0;
+        uint32_t size = 0;
+        in.read(reinterpret_cast<char*>(&config), sizeof(config));
+        in.read(reinterpret_cast<char*>(&size), sizeof(size));
+        OffsetSet offsets(size);
+        in.read(reinterpret_cast<char*>(offsets.data()), size * sizeof(std::pair<int, int>));
+        if (!in) {
+            std::cerr << "Truncated pattern database cache " << cachePath << std::endl;
+            return false;
+        }
+        loaded.emplace(config, std::move(offsets));
+    }
+
+    std::lock_guard<std::mutex> lock(tableMutex);
+    table = std::move(loaded);
+    return true;
+}
+
+bool PatternDatabaseHeuristic::save() const {
+    std::lock_guard<std::mutex> lock(tableMutex);
+    std::ofstream out(cachePath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+
+    uint64_t entries = table.size();
+    out.write(reinterpret_cast<const char*>(&CACHE_MAGIC), sizeof(CACHE_MAGIC));
+    out.write(reinterpret_cast<const char*>(&CACHE_VERSION), sizeof(CACHE_VERSION));
+    out.write(reinterpret_cast<const char*>(&entries), sizeof(entries));
+    for (const auto& [config, offsets] : table) {
+        uint32_t size = static_cast<uint32_t>(offsets.size());
+        out.write(reinterpret_cast<const char*>(&config), sizeof(config));
+        out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        out.write(reinterpret_cast<const char*>(offsets.data()), size * sizeof(std::pair<int, int>));
+    }
+
+    dirty = !out;
+    return static_cast<bool>(out);
+}
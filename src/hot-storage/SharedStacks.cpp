@@ -0,0 +1,104 @@
+#include "SharedStacks.h"
+#include <algorithm>
+
+SharedState StackCellPool::store(const AStarState& state) {
+    return build(state, nullptr, nullptr);
+}
+
+SharedState StackCellPool::share(const AStarState& state, const AStarState& parent, const SharedState& parentShared) {
+    return build(state, &parent, &parentShared);
+}
+
+SharedState StackCellPool::build(const AStarState& state, const AStarState* parent, const SharedState* parentShared) {
+    SharedState shared;
+    static_cast<StateHeader&>(shared) = state;
+    const StackArray& stacks = state.stacks;
+    shared.stacks.stackCount = stacks.stackCount;
+    shared.stacks.exitBottomTime = stacks.exitBottomTime;
+
+    for (int s = 0; s < stacks.stackCount; s++) {
+        int start = s == 0 ? 0 : stacks.ends[s - 1];
+        int height = stacks.ends[s] - start;
+        const ContainerIndex* slots = stacks.slots + start;
+
+        // Keep the bottom the parent already has, push the rest
+        uint32_t cell = SharedStacks::EMPTY;
+        int common = 0;
+        if (parent) {
+            const StackArray& parentStacks = parent->stacks;
+            int parentStart = s == 0 ? 0 : parentStacks.ends[s - 1];
+            int parentHeight = parentStacks.ends[s] - parentStart;
+            const ContainerIndex* parentSlots = parentStacks.slots + parentStart;
+            int limit = std::min(height, parentHeight);
+            while (common < limit && slots[common] == parentSlots[common]) {
+                common++;
+            }
+            cell = parentShared->stacks.tops[s];
+            for (int i = parentHeight; i > common; i--) {
+                cell = cells[cell].below;
+            }
+        }
+        for (int i = common; i < height; i++) {
+            cell = push(cell, slots[i]);
+        }
+
+        retain(cell);
+        shared.stacks.tops[s] = cell;
+        shared.stacks.heights[s] = static_cast<uint8_t>(height);
+    }
+    return shared;
+}
+
+AStarState StackCellPool::restore(const SharedState& shared) const {
+    AStarState state;
+    static_cast<StateHeader&>(state) = shared;
+    StackArray& stacks = state.stacks;
+    stacks.stackCount = shared.stacks.stackCount;
+    stacks.exitBottomTime = shared.stacks.exitBottomTime;
+
+    int end = 0;
+    for (int s = 0; s < stacks.stackCount; s++) {
+        end += shared.stacks.heights[s];
+        stacks.ends[s] = static_cast<uint8_t>(end);
+        uint32_t cell = shared.stacks.tops[s];
+        for (int i = end - 1; cell != SharedStacks::EMPTY; i--) {
+            stacks.slots[i] = cells[cell].container;
+            cell = cells[cell].below;
+        }
+    }
+    return state;
+}
+
+void StackCellPool::release(const SharedState& shared) {
+    for (int s = 0; s < shared.stacks.stackCount; s++) {
+        drop(shared.stacks.tops[s]);
+    }
+}
+
+void StackCellPool::clear() {
+    cells.clear();
+    freeCells.clear();
+    peak = 0;
+}
+
+uint32_t StackCellPool::push(uint32_t below, ContainerIndex container) {
+    uint32_t cell;
+    if (!freeCells.empty()) {
+        cell = freeCells.back();
+        freeCells.pop_back();
+    } else {
+        cell = static_cast<uint32_t>(cells.size());
+        cells.push_back({});
+    }
+    cells[cell] = {below, 0, container};
+    retain(below);
+    peak = std::max(peak, liveCells());
+    return cell;
+}
+
+void StackCellPool::drop(uint32_t cell) {
+    while (cell != SharedStacks::EMPTY && --cells[cell].refs == 0) {
+        freeCells.push_back(cell);
+        cell = cells[cell].below;
+    }
+}
@@ -0,0 +1,114 @@
+#include "StateEncoding.h"
+#include <algorithm>
+
+namespace {
+
+class BitWriter {
+public:
+    explicit BitWriter(uint64_t* out) : out(out), pos(0) {}
+
+    void write(uint64_t value, int width) {
+        size_t word = pos >> 6;
+        int offset = pos & 63;
+        out[word] |= value << offset;
+        if (offset + width > 64) {
+            out[word + 1] |= value >> (64 - offset);
+        }
+        pos += width;
+    }
+
+private:
+    uint64_t* out;
+    size_t pos;
+};
+
+class BitReader {
+public:
+    explicit BitReader(const uint64_t* in) : in(in), pos(0) {}
+
+    uint64_t read(int width) {
+        size_t word = pos >> 6;
+        int offset = pos & 63;
+        uint64_t value = in[word] >> offset;
+        if (offset + width > 64) {
+            value |= in[word + 1] << (64 - offset);
+        }
+        pos += width;
+        return value & ((uint64_t(1) << width) - 1);
+    }
+
+private:
+    const uint64_t* in;
+    size_t pos;
+};
+
+}
+
+StateEncoding::StateEncoding(const AStarState& initialState)
+    : stackCount(static_cast<int>(initialState.stacks.size())) {
+    int exitStack = stackCount - 1;
+    for (int s = 0; s < exitStack; s++) {
+        for (const auto& container : initialState.stacks[s]) {
+            containers.push_back(container.getIndex());
+        }
+    }
+    if (initialState.crane.hasContainer) {
+        containers.push_back(initialState.crane.heldContainer);
+    }
+
+    ContainerIndex maxIndex = 0;
+    for (ContainerIndex container : containers) {
+        maxIndex = std::max(maxIndex, container);
+    }
+    codes.assign(containers.empty() ? 0 : maxIndex + 1, 0);
+    for (size_t i = 0; i < containers.size(); i++) {
+        codes[containers[i]] = static_cast<uint16_t>(i + 1);
+    }
+
+    positionBits = bitsFor(stackCount - 1);
+    slotBits = bitsFor(static_cast<int>(containers.size()));
+    // Held container, every container once and one terminator per stack
+    bits = positionBits + slotBits * (1 + containers.size() + exitStack);
+    words = (bits + 63) / 64;
+}
+
+int StateEncoding::bitsFor(int maxValue) {
+    int width = 1;
+    while ((1 << width) <= maxValue) {
+        width++;
+    }
+    return width;
+}
+
+void StateEncoding::encode(const AStarState& state, uint64_t* out) const {
+    std::fill(out, out + words, 0);
+    BitWriter writer(out);
+    writer.write(state.crane.position, positionBits);
+    writer.write(state.crane.hasContainer ? codes[state.crane.heldContainer] : 0, slotBits);
+    for (int s = 0; s + 1 < stackCount; s++) {
+        for (const auto& container : state.stacks[s]) {
+            writer.write(codes[container.getIndex()], slotBits);
+        }
+        writer.write(0, slotBits);
+    }
+}
+
+AStarState StateEncoding::decode(const uint64_t* in) const {
+    AStarState state;
+    BitReader reader(in);
+    state.crane.position = static_cast<int>(reader.read(positionBits));
+    uint64_t held = reader.read(slotBits);
+    state.crane.hasContainer = held != 0;
+    state.crane.heldContainer = held != 0 ? containers[held - 1] : NO_CONTAINER;
+    for (int s = 0; s < stackCount; s++) {
+        state.stacks.addStack();
+        if (s + 1 == stackCount) {
+            break;
+        }
+        for (uint64_t code = reader.read(slotBits); code != 0; code = reader.read(slotBits)) {
+            state.stacks.push(s, containers[code - 1]);
+        }
+    }
+    state.fingerprint = state.computeFingerprint();
+    return state;
+}
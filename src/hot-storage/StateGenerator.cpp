@@ -1,5 +1,7 @@
 #include "StateGenerator.h"
+#include "Zobrist.h"
 #include <algorithm>
+#include <optional>
 #include <cmath>
 #include <iostream>
 #include <climits>
@@ -28,15 +30,47 @@ StateGenerator::StateGenerator(const ParsedBuffers& buffers) : buffers(buffers)
 }
 
 std::vector<std::pair<AStarState, double>> 
-StateGenerator::generateSuccessors(const AStarState& current) const {
+StateGenerator::generateSuccessors(const AStarState& current, std::vector<Action>* actions) const {
     std::vector<std::pair<AStarState, double>> successors;
+    if (actions) {
+        actions->clear();
+    }
 
-    if (!current.crane.hasContainer) {
+    if (!current.crane.hasContainer && macroActions) {
+        for (size_t i = 0; i < current.stacks.size(); i++) {
+            if (!current.canPickUpFrom(i)) {
+                continue;
+            }
+            double pickCost;
+            AStarState picked = applyPickUp(current, i, pickCost);
+            for (size_t j = 0; j < picked.stacks.size(); j++) {
+                if (picked.canPutDownOn(j, buffers.getBufferSize())) {
+                    double putCost;
+                    AStarState newState = applyPutDown(picked, j, putCost);
+                    newState.lastAction.kind = LastAction::RELOCATE;
+                    newState.lastAction.fromStack = i;
+                    successors.push_back({std::move(newState), pickCost + putCost});
+                    if (actions) {
+                        actions->emplace_back(Action::RELOCATE, j, "", 0, i);
+                    }
+                }
+            }
+            if (exitBlockedUntilCleared(picked)) {
+                successors.push_back({std::move(picked), pickCost});
+                if (actions) {
+                    actions->emplace_back(Action::PICK_UP, i, "");
+                }
+            }
+        }
+    } else if (!current.crane.hasContainer) {
                 for (size_t i = 0; i < current.stacks.size(); i++) {
             if (current.canPickUpFrom(i)) {
                 double cost;
                 AStarState newState = applyPickUp(current, i, cost);
                 successors.push_back({newState, cost});
+                if (actions) {
+                    actions->emplace_back(Action::PICK_UP, i, "");
+                }
             }
         }
     } else {
@@ -45,18 +79,33 @@ StateGenerator::generateSuccessors(const AStarState& current) const {
                 double cost;
                 AStarState newState = applyPutDown(current, i, cost);
                 successors.push_back({newState, cost});
+                if (actions) {
+                    actions->emplace_back(Action::PUT_DOWN, i, "");
+                }
             }
         }
     }
 
         if (shouldConsiderWaiting(current)) {
         int waitTime = calculateOptimalWaitTime(current);
-        if (waitTime > 0 && waitTime <= MAX_WAIT_TIME) {
+        if (waitTime > 0) {
             double waitCost;
             AStarState waitedState = applyWait(current, waitTime, waitCost);
             successors.push_back({waitedState, waitCost});
+            if (actions) {
+                actions->emplace_back(Action::WAIT, -1, "", waitTime);
+            }
         }
     }
+    #ifdef DEBUG
+    for (const auto& succ : successors) {
+        if (succ.first.fingerprint != succ.first.computeFingerprint()) {
+            std::cerr << "[ERROR] Incremental fingerprint mismatch after: "
+                      << succ.first.lastAction << std::endl;
+            abort();
+        }
+    }
+    #endif
 /*for (const auto& succ : successors) {
     const AStarState& state = succ.first;
     std::cout << "==== Generated State ====\n";
@@ -65,7 +114,7 @@ StateGenerator::generateSuccessors(const AStarState& current) const {
     std::cout << "Crane position: " << state.crane.position 
               << " | Holding: " << (state.crane.hasContainer ? "YES" : "NO") << "\n";
     if (state.crane.hasContainer) {
-        std::cout << "  Held container ID: " << state.crane.containerId << "\n";
+        std::cout << "  Held container ID: " << state.crane.getHeldContainer()->getId() << "\n";
     }
     for (size_t i = 0; i < state.stacks.size(); ++i) {
         std::cout << "Stack " << i << ": ";
@@ -83,6 +132,147 @@ StateGenerator::generateSuccessors(const AStarState& current) const {
     return successors;
 }
 
+std::vector<std::pair<AStarState, double>>
+StateGenerator::generateSuccessorsInBand(const AStarState& current, int g,
+                                         int minBound, int maxBound, int& nextBound,
+                                         std::vector<int>* bounds) const {
+    std::vector<std::pair<AStarState, double>> successors;
+    nextBound = INT_MAX;
+    if (bounds) {
+        bounds->clear();
+    }
+
+    // Same operators in the same order as generateSuccessors(); each one is
+    // bounded first and only copied into a new state when it falls in the band
+    auto consider = [&](int bound, auto&& apply) {
+        if (bound > maxBound) {
+            nextBound = std::min(nextBound, bound);
+        } else if (bound > minBound) {
+            double cost;
+            AStarState newState = apply(cost);
+            successors.push_back({std::move(newState), cost});
+            if (bounds) {
+                bounds->push_back(bound);
+            }
+        }
+    };
+
+    int cycleTime = craneLowerTime + craneLiftTime;
+    if (!current.crane.hasContainer && macroActions) {
+        for (size_t i = 0; i < current.stacks.size(); i++) {
+            if (!current.canPickUpFrom(i)) {
+                continue;
+            }
+            int pickDuration = calculateCraneMoveTime(current.crane.position, i) + cycleTime;
+            std::optional<AStarState> picked;
+            double pickCost = 0;
+            for (size_t j = 0; j < current.stacks.size(); j++) {
+                int duration = pickDuration + calculateCraneMoveTime(i, j) + cycleTime;
+                int bound = successorLowerBound(current, g, duration, j, false, i, j);
+                if (bound <= minBound) {
+                    continue;
+                }
+                // canPutDownOn() needs the container on the crane
+                if (!picked) {
+                    picked = applyPickUp(current, i, pickCost);
+                }
+                if (picked->canPutDownOn(j, buffers.getBufferSize())) {
+                    consider(bound, [&](double& cost) {
+                        AStarState newState = applyPutDown(*picked, j, cost);
+                        newState.lastAction.kind = LastAction::RELOCATE;
+                        newState.lastAction.fromStack = i;
+                        cost += pickCost;
+                        return newState;
+                    });
+                }
+            }
+            int holdBound = successorLowerBound(current, g, pickDuration, i, true, i, -1);
+            if (holdBound > minBound) {
+                if (!picked) {
+                    picked = applyPickUp(current, i, pickCost);
+                }
+                if (exitBlockedUntilCleared(*picked)) {
+                    consider(holdBound, [&](double& cost) {
+                        cost = pickCost;
+                        return *picked;
+                    });
+                }
+            }
+        }
+    } else if (!current.crane.hasContainer) {
+        for (size_t i = 0; i < current.stacks.size(); i++) {
+            if (current.canPickUpFrom(i)) {
+                int duration = calculateCraneMoveTime(current.crane.position, i) + cycleTime;
+                consider(successorLowerBound(current, g, duration, i, true, i, -1),
+                         [&](double& cost) { return applyPickUp(current, i, cost); });
+            }
+        }
+    } else {
+        for (size_t i = 0; i < current.stacks.size(); i++) {
+            if (current.canPutDownOn(i, buffers.getBufferSize())) {
+                int duration = calculateCraneMoveTime(current.crane.position, i) + cycleTime;
+                consider(successorLowerBound(current, g, duration, i, false, -1, i),
+                         [&](double& cost) { return applyPutDown(current, i, cost); });
+            }
+        }
+    }
+
+    if (shouldConsiderWaiting(current)) {
+        int waitTime = calculateOptimalWaitTime(current);
+        if (waitTime > 0) {
+            consider(successorLowerBound(current, g, waitTime, current.crane.position,
+                                         current.crane.hasContainer, -1, -1),
+                     [&](double& cost) { return applyWait(current, waitTime, cost); });
+        }
+    }
+
+    return successors;
+}
+
+int StateGenerator::successorLowerBound(const AStarState& current, int g, int duration, int cranePosition,
+                                        bool holding, int takenFrom, int placedOn) const {
+    // Mirrors LatenessHeuristic on the successor's layout. Lateness charged
+    // by an exit put-down and the container just put down are left out,
+    // which only lowers the bound.
+    int time = current.current_time + duration;
+    int exitStack = static_cast<int>(current.stacks.size()) - 1;
+    int perContainerTime = 2 * (craneLowerTime + craneLiftTime + craneMoveTime);
+    int heldOffset = holding ? calculateCraneMoveTime(cranePosition, exitStack) + craneLowerTime : 0;
+
+    int bound = g;
+    for (int s = 0; s < exitStack; s++) {
+        const auto& stack = current.stacks[s];
+        int height = static_cast<int>(stack.size());
+        if (s == takenFrom) {
+            height--;
+        } else if (s == placedOn) {
+            height++;
+        }
+        int reachTime = (!holding && cranePosition != s) ? calculateCraneMoveTime(cranePosition, s) : 0;
+        // Like LatenessHeuristic, the entry stack does not wait for the held container
+        int baseTime = reachTime + craneLowerTime + craneLiftTime +
+                       calculateCraneMoveTime(s, exitStack) + craneLowerTime + (s > 0 ? heldOffset : 0);
+        int stored = std::min(height, static_cast<int>(stack.size()));
+        for (int pos = 0; pos < stored; pos++) {
+            const auto& container = stack[pos];
+            if (container.getExitTime() != -1) {
+                continue;
+            }
+            int exitTime = time + baseTime + (height - pos - 1) * perContainerTime;
+            int dueTime = container.getArrivalTime() + container.getDueIn();
+            bound += std::max(0, exitTime - dueTime);
+        }
+    }
+    return bound;
+}
+
+bool StateGenerator::exitBlockedUntilCleared(const AStarState& holding) const {
+    int exitStack = static_cast<int>(holding.stacks.size()) - 1;
+    const auto& exitContainers = holding.stacks[exitStack];
+    return !exitContainers.empty() && exitContainers.back().getExitTime() > holding.current_time &&
+           !holding.canPutDownOn(exitStack, buffers.getBufferSize());
+}
+
 bool StateGenerator::shouldConsiderWaiting(const AStarState& current) const {
         if (!canWaitingHelp(current)) {
         return false;
@@ -96,44 +286,25 @@ bool StateGenerator::shouldConsiderWaiting(const AStarState& current) const {
 }
 
 bool StateGenerator::canWaitingHelp(const AStarState& current) const {
-    auto& exitStack = current.stacks.back();
-    
-        if (!exitStack.empty()) {
-                const auto& topContainer = exitStack.back();
-        if (topContainer.getExitTime() != -1) {
-            int clearTime = topContainer.getExitTime() + clearingTime;
-            int timeUntilClear = clearTime - current.current_time;
-            
-                        if (timeUntilClear > 0 && timeUntilClear <= MAX_WAIT_TIME) {
-                return true;
-            }
-        }
-    }
-    
-        if (current.crane.hasContainer && !exitStack.empty()) {
-                const auto& topContainer = exitStack.back();
-        if (topContainer.getExitTime() != -1) {
-            int clearTime = topContainer.getExitTime() + clearingTime;
-            if (clearTime - current.current_time > 0 && 
-                clearTime - current.current_time <= MAX_WAIT_TIME) {
-                return true;
-            }
-        }
+        // A container on the exit stack that has not cleared yet
+    const auto& exitStack = current.stacks.back();
+    if (!exitStack.empty() && exitStack.back().getExitTime() > current.current_time) {
+        return true;
     }
-    
-            bool hasUrgentWork = false;
-    for (size_t i = 0; i < current.stacks.size() - 1; i++) {          if (!current.stacks[i].empty()) {
+
+        return !hasOverdueTop(current);
+}
+
+bool StateGenerator::hasOverdueTop(const AStarState& current) const {
+    for (size_t i = 0; i < current.stacks.size() - 1; i++) {
+        if (!current.stacks[i].empty()) {
             const auto& top = current.stacks[i].back();
-            if (top.getExitTime() == -1) {                  int dueTime = top.getArrivalTime() + top.getDueIn();
-                if (dueTime < current.current_time) {
-                    hasUrgentWork = true;
-                    break;
-                }
+            if (top.getExitTime() == -1 && top.getArrivalTime() + top.getDueIn() < current.current_time) {
+                return true;
             }
         }
     }
-    
-        return !hasUrgentWork;
+    return false;
 }
 
 bool StateGenerator::hasWaitedTooMuch(const AStarState& current) const {
@@ -152,24 +323,28 @@ bool StateGenerator::hasWaitedTooMuch(const AStarState& current) const {
 }
 
 int StateGenerator::calculateOptimalWaitTime(const AStarState& current) const {
-    int minWaitTime = INT_MAX;
-    auto& exitStack = current.stacks.back();
-    
-        if (!exitStack.empty()) {
-                const auto& topContainer = exitStack.back();
-        if (topContainer.getExitTime() != -1) {
-            int clearTime = topContainer.getExitTime() + clearingTime;
-            int timeUntilClear = clearTime - current.current_time;
-            
-            if (timeUntilClear > 0) {
-                minWaitTime = timeUntilClear;
+    // A wait jumps straight to the next event: the exit stack's top container
+    // clearing or, while nothing is overdue, a stored container falling due.
+    // Arrivals are not part of the planned state, so they are no event here.
+    int nextEvent = INT_MAX;
+    const auto& exitStack = current.stacks.back();
+    if (!exitStack.empty() && exitStack.back().getExitTime() > current.current_time) {
+        nextEvent = exitStack.back().getExitTime();
+    }
+
+    if (!hasOverdueTop(current)) {
+        for (size_t i = 0; i < current.stacks.size() - 1; i++) {
+            for (const auto& container : current.stacks[i]) {
+                int dueTime = container.getArrivalTime() + container.getDueIn();
+                if (dueTime > current.current_time) {
+                    nextEvent = std::min(nextEvent, dueTime);
+                }
             }
         }
     }
-    
-        return std::min(minWaitTime, MAX_WAIT_TIME);
-}
 
+    return nextEvent == INT_MAX ? 0 : nextEvent - current.current_time;
+}
 
 std::vector<Action> StateGenerator::getValidActions(const AStarState& current) const {
     std::vector<Action> actions;
@@ -187,7 +362,7 @@ std::vector<Action> StateGenerator::getValidActions(const AStarState& current) c
                 for (size_t i = 0; i < current.stacks.size(); i++) {
             if (current.canPutDownOn(i, buffers.getBufferSize())) {
                 std::string desc = "Put down " + 
-                    current.crane.containerId + 
+                    current.crane.getHeldContainer()->getId() + 
                     " on stack " + std::to_string(i);
                 actions.push_back(Action(Action::PUT_DOWN, i, desc));
             }
@@ -218,27 +393,30 @@ AStarState StateGenerator::applyPickUp(const AStarState& current,
         cost += moveTime;
         newState.current_time += moveTime;
         newState.crane.position = stackIndex;
+        newState.fingerprint ^= ZobristKeys::craneKey(current.crane.position) ^
+                                ZobristKeys::craneKey(stackIndex);
         
-                updateAllContainerTimes(newState, moveTime);
-        clearExitedContainers(newState, moveTime);
+                clearExitedContainers(newState, moveTime);
     }
     
         int pickUpTime = craneLowerTime + craneLiftTime;
     cost += pickUpTime;
     newState.current_time += pickUpTime;
     
-        UntilDueContainer pickedContainer = newState.stacks[stackIndex].back();
-    newState.stacks[stackIndex].pop_back();
+        ContainerIndex pickedContainer = newState.stacks.pop(stackIndex);
+    newState.fingerprint ^= ZobristKeys::placementKey(pickedContainer, stackIndex,
+                                                      newState.stacks[stackIndex].size()) ^
+                            ZobristKeys::heldKey(pickedContainer);
     
         newState.crane.hasContainer = true;
-    newState.crane.containerId = pickedContainer.getId();
     newState.crane.heldContainer = pickedContainer;
     
-        updateAllContainerTimes(newState, pickUpTime);
     clearExitedContainers(newState, pickUpTime);
     
-        newState.lastAction = "Picked up " + pickedContainer.getId() + 
-                         " from stack " + std::to_string(stackIndex);
+        newState.lastAction = LastAction();
+    newState.lastAction.kind = LastAction::PICK_UP;
+    newState.lastAction.fromStack = stackIndex;
+    newState.lastAction.container = pickedContainer;
     newState.accumulatedCost = current.accumulatedCost + cost;
     
     #ifdef DEBUG
@@ -264,92 +442,62 @@ AStarState StateGenerator::applyPutDown(const AStarState& current,
         cost += moveTime;
         newState.current_time += moveTime;
         newState.crane.position = stackIndex;
+        newState.fingerprint ^= ZobristKeys::craneKey(current.crane.position) ^
+                                ZobristKeys::craneKey(stackIndex);
         
-                updateAllContainerTimes(newState, moveTime);
-        clearExitedContainers(newState, moveTime);
+                clearExitedContainers(newState, moveTime);
     }
     
         int putDownTime = craneLowerTime;
     cost += putDownTime;
     newState.current_time += putDownTime;
     
-        if (!current.crane.heldContainer.has_value()) {
+        if (current.crane.heldContainer == NO_CONTAINER) {
         std::cerr << "[ERROR] Crane is not holding any container in applyPutDown(). Aborting!" << std::endl;
         abort();
     }
-    UntilDueContainer newContainer = current.crane.heldContainer.value();
+    ContainerView newContainer(current.crane.heldContainer);
+    bool toExit = stackIndex == static_cast<int>(newState.stacks.size()) - 1;
     
-        if (stackIndex == static_cast<int>(newState.stacks.size()) - 1) {
+        if (toExit) {
                 int nextBoundary = ((newState.current_time / 60) + 1) * 60;
-        
-                int existingContainers = newState.stacks[stackIndex].size();
-        
-                newContainer.setExitTime(nextBoundary);
 
         if ((newState.current_time - newContainer.getDueIn()) > 0){
             newState.setTotalLateness(accumulatedLateness + newState.current_time - newContainer.getDueIn());
         }
         
-        
-                for (size_t i = 0; i < newState.stacks[stackIndex].size(); i++) {
-                        int containerClearTime = nextBoundary + ((existingContainers - i) * 60);
-            newState.stacks[stackIndex][i].setExitTime(containerClearTime);
-        }
+                newState.stacks.pushToExit(current.crane.heldContainer, nextBoundary);
+    } else {
+        newState.fingerprint ^= ZobristKeys::placementKey(current.crane.heldContainer, stackIndex,
+                                                          newState.stacks[stackIndex].size());
+        newState.stacks.push(stackIndex, current.crane.heldContainer);
     }
-    
-        newState.stacks[stackIndex].push_back(newContainer);
+    newState.fingerprint ^= ZobristKeys::heldKey(current.crane.heldContainer);
     
         newState.crane.hasContainer = false;
-    newState.crane.containerId = "";
-    newState.crane.heldContainer = std::nullopt;
+    newState.crane.heldContainer = NO_CONTAINER;
     
         int liftTime = craneLiftTime;
     cost += liftTime;
     newState.current_time += liftTime;
     
-        updateAllContainerTimes(newState, putDownTime + liftTime);
     clearExitedContainers(newState, putDownTime + liftTime);
     
-        newState.lastAction = "Put down " + newContainer.getId() + 
-                         " on stack " + std::to_string(stackIndex);
-    if (stackIndex == static_cast<int>(newState.stacks.size()) - 1) {
-        newState.lastAction += " (EXIT)";
-    }
+        newState.lastAction = LastAction();
+    newState.lastAction.kind = LastAction::PUT_DOWN;
+    newState.lastAction.toStack = stackIndex;
+    newState.lastAction.toExit = toExit;
+    newState.lastAction.container = current.crane.heldContainer;
     newState.accumulatedCost = current.accumulatedCost + cost;
     
     return newState;
 }
 
-void StateGenerator::updateAllContainerTimes(AStarState& state, int elapsedTime) const {
-    for (auto& stack : state.stacks) {
-        for (auto& container : stack) {
-            if (container.getExitTime() == -1) {                                  int totalSeconds = container.getUntilDue().getMinutes() * 60 + 
-                                  container.getUntilDue().getSeconds();
-                totalSeconds -= elapsedTime;
-                
-                                int newMinutes = totalSeconds / 60;
-                int newSeconds = totalSeconds % 60;
-                
-                                if (totalSeconds < 0) {
-                    newMinutes = -((-totalSeconds) / 60);
-                    newSeconds = -((-totalSeconds) % 60);
-                }
-                
-                UntilDue newUntilDue(newMinutes, newSeconds);
-                container.setUntilDue(newUntilDue);
-                
-                            }
-        }
-    }
-}
-
 void StateGenerator::clearExitedContainers(AStarState& state, int time) const {
-    auto& exitStack = state.stacks.back(); 
-        while (!exitStack.empty()) {
-        const auto& topContainer = exitStack.back();
-                if (topContainer.getExitTime() != -1 &&
-            topContainer.getExitTime() <= state.current_time) {
-                        exitStack.pop_back();
+    int exitStack = static_cast<int>(state.stacks.size()) - 1;
+        while (!state.stacks[exitStack].empty()) {
+                if (state.stacks[exitStack].back().getExitTime() <= state.current_time) {
+                        state.stacks.pop(exitStack);
         } else {
             break;
         }
@@ -365,15 +513,40 @@ AStarState StateGenerator::applyWait(const AStarState& current, int waitTime, do
     
     newState.current_time += waitTime;
 
-        updateAllContainerTimes(newState, waitTime);
+    // Waiting only clears exited containers, so the fingerprint carries over unchanged
+
     clearExitedContainers(newState, waitTime);
 
-    newState.lastAction = "Waited for " + std::to_string(waitTime) + " seconds";
+    newState.lastAction = LastAction();
+    newState.lastAction.kind = LastAction::WAIT;
+    newState.lastAction.waitTime = waitTime;
     newState.accumulatedCost = current.accumulatedCost + cost;
 
     return newState;
 }
 
+AStarState StateGenerator::applyAction(const AStarState& current, const LastAction& action) const {
+    double cost;
+    switch (action.kind) {
+        case LastAction::PICK_UP:
+            return applyPickUp(current, action.fromStack, cost);
+        case LastAction::PUT_DOWN:
+            return applyPutDown(current, action.toStack, cost);
+        case LastAction::RELOCATE: {
+            double putCost;
+            AStarState newState = applyPutDown(applyPickUp(current, action.fromStack, cost), action.toStack, putCost);
+            newState.lastAction.kind = LastAction::RELOCATE;
+            newState.lastAction.fromStack = action.fromStack;
+            return newState;
+        }
+        case LastAction::WAIT:
+            return applyWait(current, action.waitTime, cost);
+        case LastAction::INITIAL:
+            break;
+    }
+    return current;
+}
+
 
 int StateGenerator::calculateCraneMoveTime(int from, int to) const {
     return std::abs(to - from) * craneMoveTime;
@@ -0,0 +1,179 @@
+#include "StateRanking.h"
+#include <algorithm>
+
+namespace {
+
+uint64_t saturatingAdd(uint64_t a, uint64_t b) {
+    return a > StateRanking::SATURATED - b ? StateRanking::SATURATED : a + b;
+}
+
+uint64_t saturatingMul(uint64_t a, uint64_t b) {
+    return b != 0 && a > StateRanking::SATURATED / b ? StateRanking::SATURATED : a * b;
+}
+
+// Bit code - 1 is set for every container code not yet placed
+uint64_t codesAbove(int placed, int n) {
+    uint64_t all = n >= 64 ? ~uint64_t(0) : (uint64_t(1) << n) - 1;
+    uint64_t below = placed >= 64 ? ~uint64_t(0) : (uint64_t(1) << placed) - 1;
+    return all & ~below;
+}
+
+// Position of a code among the free ones, in code order
+int indexOf(uint64_t free, int code) {
+    return __builtin_popcountll(free & ((uint64_t(1) << (code - 1)) - 1));
+}
+
+int codeAt(uint64_t free, uint64_t index) {
+    for (; index > 0; index--) {
+        free &= free - 1;
+    }
+    return __builtin_ctzll(free) + 1;
+}
+
+}
+
+StateRanking::StateRanking(const AStarState& initialState, int bufferSize)
+    : stackCount(static_cast<int>(initialState.stacks.size())), entryHeight(0), maxHeight(0), stateCount(0) {
+    int exitStack = stackCount - 1;
+    for (int s = 0; s < exitStack; s++) {
+        for (const auto& container : initialState.stacks[s]) {
+            containers.push_back(container.getIndex());
+        }
+    }
+    if (initialState.crane.hasContainer) {
+        containers.push_back(initialState.crane.heldContainer);
+    }
+    entryHeight = exitStack > 0 ? static_cast<int>(initialState.stacks[0].size()) : 0;
+
+    ContainerIndex maxIndex = 0;
+    for (ContainerIndex container : containers) {
+        maxIndex = std::max(maxIndex, container);
+    }
+    codes.assign(containers.empty() ? 0 : maxIndex + 1, 0);
+    for (size_t i = 0; i < containers.size(); i++) {
+        codes[containers[i]] = static_cast<uint16_t>(i + 1);
+    }
+
+    int n = getContainerCount();
+    for (int s = 1; s < exitStack; s++) {
+        int height = std::max(bufferSize, static_cast<int>(initialState.stacks[s].size()));
+        capacities.push_back(std::min(height, n));
+        maxHeight = std::max(maxHeight, capacities.back());
+    }
+
+    int buffers = static_cast<int>(capacities.size());
+    completions.assign(static_cast<size_t>(buffers) * (maxHeight + 1) * (n + 1), 0);
+    for (int b = buffers - 1; b >= 0; b--) {
+        for (int h = capacities[b]; h >= 0; h--) {
+            for (int free = 0; free <= n; free++) {
+                uint64_t count = ways(b + 1, 0, free);
+                if (h < capacities[b] && free > 0) {
+                    count = saturatingAdd(count, saturatingMul(free, ways(b, h + 1, free - 1)));
+                }
+                completions[(static_cast<size_t>(b) * (maxHeight + 1) + h) * (n + 1) + free] = count;
+            }
+        }
+    }
+
+    // Entry stack heights from 0 up, each followed by every held choice
+    uint64_t start = 0;
+    for (int h0 = 0; h0 <= entryHeight; h0++) {
+        blockStart.push_back(start);
+        start = saturatingAdd(start, block(n - h0));
+    }
+    blockStart.push_back(start);
+    stateCount = saturatingMul(start, stackCount);
+}
+
+uint64_t StateRanking::ways(int stack, int height, int free) const {
+    if (stack == static_cast<int>(capacities.size())) {
+        return 1;
+    }
+    return completions[(static_cast<size_t>(stack) * (maxHeight + 1) + height) * (getContainerCount() + 1) + free];
+}
+
+uint64_t StateRanking::block(int free) const {
+    uint64_t count = ways(0, 0, free);
+    if (free > 0) {
+        count = saturatingAdd(count, saturatingMul(free, ways(0, 0, free - 1)));
+    }
+    return count;
+}
+
+uint64_t StateRanking::rank(const AStarState& state) const {
+    int n = getContainerCount();
+    int h0 = static_cast<int>(state.stacks[0].size());
+    uint64_t free = codesAbove(h0, n);
+    int left = n - h0;
+    uint64_t index = blockStart[h0];
+
+    if (state.crane.hasContainer) {
+        int code = codes[state.crane.heldContainer];
+        index += ways(0, 0, left) + indexOf(free, code) * ways(0, 0, left - 1);
+        free &= ~(uint64_t(1) << (code - 1));
+        left--;
+    }
+
+    for (int b = 0; b < static_cast<int>(capacities.size()); b++) {
+        int h = 0;
+        for (const auto& container : state.stacks[b + 1]) {
+            int code = codes[container.getIndex()];
+            index += ways(b + 1, 0, left) + indexOf(free, code) * ways(b, h + 1, left - 1);
+            free &= ~(uint64_t(1) << (code - 1));
+            left--;
+            h++;
+        }
+    }
+
+    return index * stackCount + state.crane.position;
+}
+
+AStarState StateRanking::unrank(uint64_t rank) const {
+    AStarState state;
+    int n = getContainerCount();
+    state.crane.position = static_cast<int>(rank % stackCount);
+    uint64_t index = rank / stackCount;
+
+    int h0 = static_cast<int>(std::upper_bound(blockStart.begin(), blockStart.end(), index) - blockStart.begin()) - 1;
+    index -= blockStart[h0];
+    uint64_t free = codesAbove(h0, n);
+    int left = n - h0;
+
+    if (index >= ways(0, 0, left)) {
+        index -= ways(0, 0, left);
+        uint64_t rest = ways(0, 0, left - 1);
+        int code = codeAt(free, index / rest);
+        index %= rest;
+        state.crane.hasContainer = true;
+        state.crane.heldContainer = containers[code - 1];
+        free &= ~(uint64_t(1) << (code - 1));
+        left--;
+    }
+
+    state.stacks.addStack();
+    for (int i = 0; i < h0; i++) {
+        state.stacks.push(0, containers[i]);
+    }
+    for (int b = 0; b < static_cast<int>(capacities.size()); b++) {
+        state.stacks.addStack();
+        for (int h = 0;; h++) {
+            uint64_t stop = ways(b + 1, 0, left);
+            if (index < stop) {
+                break;
+            }
+            index -= stop;
+            uint64_t rest = ways(b, h + 1, left - 1);
+            int code = codeAt(free, index / rest);
+            index %= rest;
+            state.stacks.push(b + 1, containers[code - 1]);
+            free &= ~(uint64_t(1) << (code - 1));
+            left--;
+        }
+    }
+    if (stackCount > 1) {
+        state.stacks.addStack();
+    }
+
+    state.fingerprint = state.computeFingerprint();
+    return state;
+}
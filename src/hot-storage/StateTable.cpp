@@ -0,0 +1,185 @@
+#include "StateTable.h"
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <limits>
+
+StateTable::StateTable(size_t expectedStates)
+    : encodingWords(0), denseStates(0), count(0), mask(0), shift(64), lookups(0), probes(0), maxProbeLength(0), keyCollisions(0) {
+    reserve(expectedStates);
+}
+
+void StateTable::setEncodingWords(size_t words) {
+    encodingWords = words;
+    size_t slotCount = slots.size();
+    slots.clear();
+    encodings.clear();
+    if (slotCount > 0) {
+        allocate(slotCount);
+    }
+    lookups = 0;
+    probes = 0;
+    maxProbeLength = 0;
+    keyCollisions = 0;
+}
+
+void StateTable::setDenseStates(size_t states) {
+    if (states == denseStates) {
+        return;
+    }
+    denseStates = states;
+    slots.clear();
+    encodings.clear();
+    if (denseStates > 0) {
+        allocate(denseStates);
+    }
+    lookups = 0;
+    probes = 0;
+    maxProbeLength = 0;
+    keyCollisions = 0;
+}
+
+void StateTable::reserve(size_t expectedStates) {
+    if (denseStates > 0) {
+        return;
+    }
+    size_t wanted = 16;
+    while (wanted * MAX_LOAD < expectedStates) {
+        wanted <<= 1;
+    }
+    if (wanted <= slots.size()) {
+        return;
+    }
+    if (count == 0) {
+        allocate(wanted);
+        return;
+    }
+    while (slots.size() < wanted) {
+        grow();
+    }
+}
+
+void StateTable::clear() {
+    for (auto& slot : slots) {
+        slot.occupied = false;
+    }
+    count = 0;
+    lookups = 0;
+    probes = 0;
+    maxProbeLength = 0;
+    keyCollisions = 0;
+}
+
+void StateTable::allocate(size_t slotCount) {
+    slots.assign(slotCount, Entry{0, 0, 0, false, false});
+    encodings.assign(slotCount * encodingWords, 0);
+    mask = slotCount - 1;
+    shift = 64;
+    for (size_t n = slotCount; n > 1; n >>= 1) {
+        shift--;
+    }
+    count = 0;
+}
+
+void StateTable::grow() {
+    std::vector<Entry> old;
+    std::vector<uint64_t> oldEncodings;
+    old.swap(slots);
+    oldEncodings.swap(encodings);
+    allocate(old.empty() ? 16 : old.size() * 2);
+
+    for (size_t slot = 0; slot < old.size(); slot++) {
+        if (!old[slot].occupied) {
+            continue;
+        }
+        size_t i = home(old[slot].key);
+        while (slots[i].occupied) {
+            i = (i + 1) & mask;
+        }
+        slots[i] = old[slot];
+        std::copy_n(oldEncodings.begin() + slot * encodingWords, encodingWords,
+                    encodings.begin() + i * encodingWords);
+        count++;
+    }
+}
+
+bool StateTable::sameEncoding(size_t slot, const uint64_t* encoding) const {
+    return std::equal(encoding, encoding + encodingWords, encodings.begin() + slot * encodingWords);
+}
+
+size_t StateTable::probe(uint64_t key, const uint64_t* encoding, bool& found) {
+    if (denseStates > 0) {
+        lookups++;
+        probes++;
+        maxProbeLength = 1;
+        found = slots[key].occupied;
+        return key;
+    }
+
+    size_t i = home(key);
+    size_t length = 1;
+    bool exact = encoding && encodingWords > 0;
+    while (slots[i].occupied) {
+        if (slots[i].key == key) {
+            if (!exact || sameEncoding(i, encoding)) {
+                break;
+            }
+            keyCollisions++;
+        }
+        i = (i + 1) & mask;
+        length++;
+    }
+
+    lookups++;
+    probes += length;
+    if (length > maxProbeLength) {
+        maxProbeLength = length;
+    }
+
+    found = slots[i].occupied;
+    return i;
+}
+
+StateTable::Entry* StateTable::find(uint64_t key, const uint64_t* encoding) {
+    if (slots.empty()) {
+        return nullptr;
+    }
+    bool found;
+    size_t i = probe(key, encoding, found);
+    return found ? &slots[i] : nullptr;
+}
+
+StateTable::Entry& StateTable::findOrInsert(uint64_t key, const uint64_t* encoding, bool& inserted) {
+    if (denseStates == 0 && (slots.empty() || (count + 1) > slots.size() * MAX_LOAD)) {
+        grow();
+    }
+
+    bool found;
+    size_t i = probe(key, encoding, found);
+    inserted = !found;
+    if (inserted) {
+        slots[i] = Entry{key, std::numeric_limits<uint64_t>::max(), 0, true, false};
+        if (encoding && encodingWords > 0) {
+            std::copy_n(encoding, encodingWords, encodings.begin() + i * encodingWords);
+        }
+        count++;
+    }
+    return slots[i];
+}
+
+void StateTable::printStatistics() const {
+    std::cout << "State table: " << count << " states in " << slots.size() << " slots"
+              << " (load " << std::fixed << std::setprecision(2) << loadFactor() << ", "
+              << bytesUsed() / 1024 << " KB, "
+              << (count ? static_cast<double>(bytesUsed()) / count : 0.0) << " bytes/state)" << std::endl;
+    if (denseStates > 0) {
+        std::cout << "Dense keys: " << denseStates << " ranked configurations, "
+                  << count * 100.0 / denseStates << "% reached" << std::endl;
+    }
+    std::cout << "State table probes: " << lookups << " lookups, average length "
+              << getAverageProbeLength() << ", max length " << maxProbeLength << std::endl;
+    if (encodingWords > 0) {
+        std::cout << "Exact keys: " << encodingWords * sizeof(uint64_t) << " encoded bytes per slot, "
+                  << keyCollisions << " fingerprint collisions resolved" << std::endl;
+    }
+}
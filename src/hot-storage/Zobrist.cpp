@@ -0,0 +1,44 @@
+#include "Zobrist.h"
+
+uint64_t ZobristKeys::mix(uint64_t x) {
+    // splitmix64 finaliser
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+uint64_t ZobristKeys::containerKey(const std::string& containerId) {
+    // FNV-1a over the id, then mixed so short ids still spread over all bits
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (unsigned char c : containerId) {
+        h ^= c;
+        h *= 0x100000001b3ULL;
+    }
+    return mix(h);
+}
+
+uint64_t ZobristKeys::slotKey(uint64_t containerKey, int stackIndex, int height) {
+    uint64_t slot = (static_cast<uint64_t>(stackIndex + 1) << 32) | static_cast<uint32_t>(height);
+    return mix(containerKey ^ mix(slot));
+}
+
+uint64_t ZobristKeys::placementKey(const std::string& containerId, int stackIndex, int height) {
+    return slotKey(containerKey(containerId), stackIndex, height);
+}
+
+uint64_t ZobristKeys::heldKey(const std::string& containerId) {
+    return mix(containerKey(containerId) ^ 0x6a09e667f3bcc908ULL);
+}
+
+uint64_t ZobristKeys::placementKey(ContainerIndex container, int stackIndex, int height) {
+    return slotKey(ContainerTable::get(container).zobristKey, stackIndex, height);
+}
+
+uint64_t ZobristKeys::heldKey(ContainerIndex container) {
+    return mix(ContainerTable::get(container).zobristKey ^ 0x6a09e667f3bcc908ULL);
+}
+
+uint64_t ZobristKeys::craneKey(int position) {
+    return mix(0x3c6ef372fe94f82bULL + static_cast<uint64_t>(position));
+}
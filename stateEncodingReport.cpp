@@ -0,0 +1,106 @@
+// Closed-set size report for StateEncoding.
+//
+// For random yards of 5, 8, 12 and 16 containers, prints the packed
+// encoding size of a configuration next to a full AStarState, then runs a
+// node-limited search in verification mode (state table keyed by the
+// encodings) and reports the table's bytes per slot and its load. Every state
+// met on random walks through each yard is encoded, decoded and compared,
+// and the program fails if one does not round-trip.
+//
+// Build:  g++ -std=c++17 -O2 stateEncodingReport.cpp -L./build -lSimulator -Iheaders/ -lpthread
+// Run:    ./a.out [max nodes per search] [seed]
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AStarSolver.h"
+#include "AStarStartingState.h"
+#include "ParsedBuffers.h"
+#include "RandomYard.h"
+#include "StateEncoding.h"
+#include "StateGenerator.h"
+
+namespace {
+
+constexpr int WALKS = 200;
+constexpr int WALK_LENGTH = 60;
+
+// Number of walked states that did not decode to the same configuration
+int checkRoundTrips(const StateGenerator& generator, const StateEncoding& encoding,
+                    const AStarState& initialState, std::mt19937& rng, int& checked) {
+    std::vector<uint64_t> encoded(encoding.getWords());
+    int failures = 0;
+    for (int walk = 0; walk < WALKS; walk++) {
+        AStarState state = initialState;
+        for (int step = 0; step < WALK_LENGTH && !state.isGoalState(); step++) {
+            auto successors = generator.generateSuccessors(state);
+            if (successors.empty()) {
+                break;
+            }
+            std::uniform_int_distribution<size_t> pick(0, successors.size() - 1);
+            state = successors[pick(rng)].first;
+
+            encoding.encode(state, encoded.data());
+            if (!encoding.decode(encoded.data()).sameConfiguration(state)) {
+                failures++;
+            }
+            checked++;
+        }
+    }
+    return failures;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int maxNodes = argc > 1 ? std::stoi(argv[1]) : 200000;
+    unsigned seed = argc > 2 ? static_cast<unsigned>(std::stoul(argv[2])) : 1;
+    const std::string instancePath = "encodingInstance.txt";
+
+    std::mt19937 rng(seed);
+    std::streambuf* console = std::cout.rdbuf();
+    std::ofstream discard("/dev/null");
+    int totalFailures = 0;
+
+    std::cout << "containers  bits  encoded B  full state B  closed states  table B/slot  load  round trips" << std::endl;
+    for (int containers : {5, 8, 12, 16}) {
+        RandomYard::writeInstance(instancePath, containers, rng);
+
+        std::cout.rdbuf(discard.rdbuf());
+        ParsedBuffers buffers(instancePath);
+        AStarState initialState = makeAStarInitialState(buffers);
+        StateEncoding encoding(initialState);
+        StateGenerator generator(buffers);
+
+        AStarSolver solver(buffers, maxNodes, false, 1);
+        solver.setVerifyFingerprints(true);
+        solver.solve(initialState);
+        std::cout.rdbuf(console);
+
+        int checked = 0;
+        int failures = checkRoundTrips(generator, encoding, initialState, rng, checked);
+        totalFailures += failures;
+
+        const StateTable& table = solver.getStateTable();
+        double slotBytes = table.capacity() ? static_cast<double>(table.bytesUsed()) / table.capacity() : 0.0;
+        std::cout << std::setw(10) << containers
+                  << std::setw(6) << encoding.getBits()
+                  << std::setw(11) << encoding.getBytes()
+                  << std::setw(14) << sizeof(AStarState)
+                  << std::setw(15) << table.size()
+                  << std::setw(14) << std::fixed << std::setprecision(1) << slotBytes
+                  << std::setw(6) << std::setprecision(2) << table.loadFactor()
+                  << std::setw(7) << checked - failures << "/" << checked << std::endl;
+    }
+    std::remove(instancePath.c_str());
+
+    if (totalFailures > 0) {
+        std::cerr << totalFailures << " states did not round-trip" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,167 @@
+// Offline trainer for LearnedHeuristic.
+//
+// Generates random yards small enough for optimal search, solves each with
+// AStarSolver, and fits a ridge regression from the features of every state
+// on the optimal plan to its remaining lateness. The weights are written as
+// a LearnedHeuristicModel.h header.
+//
+// Build:  g++ -std=c++17 -O2 trainLearnedHeuristic.cpp -L./build -lSimulator -Iheaders/ -lpthread
+// Run:    ./a.out [instances] [containers] [seed] [output header]
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AStarSolver.h"
+#include "AStarStartingState.h"
+#include "LearnedHeuristic.h"
+#include "ParsedBuffers.h"
+#include "RandomYard.h"
+
+namespace {
+
+constexpr int N = LearnedHeuristic::FEATURE_COUNT;
+constexpr double RIDGE = 1e-3;
+constexpr int MAX_NODES_PER_INSTANCE = 2000000;
+
+// Solves A w = b for the symmetric positive definite normal equations
+std::vector<double> solveLinearSystem(std::vector<std::vector<double>> a, std::vector<double> b) {
+    for (int col = 0; col < N; col++) {
+        int pivot = col;
+        for (int row = col + 1; row < N; row++) {
+            if (std::abs(a[row][col]) > std::abs(a[pivot][col])) {
+                pivot = row;
+            }
+        }
+        std::swap(a[col], a[pivot]);
+        std::swap(b[col], b[pivot]);
+        for (int row = col + 1; row < N; row++) {
+            double factor = a[row][col] / a[col][col];
+            for (int k = col; k < N; k++) {
+                a[row][k] -= factor * a[col][k];
+            }
+            b[row] -= factor * b[col];
+        }
+    }
+    std::vector<double> w(N);
+    for (int row = N - 1; row >= 0; row--) {
+        double sum = b[row];
+        for (int k = row + 1; k < N; k++) {
+            sum -= a[row][k] * w[k];
+        }
+        w[row] = sum / a[row][row];
+    }
+    return w;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int instances = argc > 1 ? std::stoi(argv[1]) : 200;
+    int containers = argc > 2 ? std::stoi(argv[2]) : 6;
+    unsigned seed = argc > 3 ? static_cast<unsigned>(std::stoul(argv[3])) : 1;
+    std::string output = argc > 4 ? argv[4] : "headers/LearnedHeuristicModel.h";
+    const std::string instancePath = "trainInstance.txt";
+
+    std::mt19937 rng(seed);
+    std::vector<LearnedHeuristic::Features> samples;
+    std::vector<double> targets;
+
+    std::streambuf* console = std::cout.rdbuf();
+    std::ofstream discard("/dev/null");
+    int solved = 0;
+
+    for (int n = 0; n < instances; n++) {
+        RandomYard::writeInstance(instancePath, containers, rng);
+
+        std::cout.rdbuf(discard.rdbuf());
+        ParsedBuffers buffers(instancePath);
+        AStarState initialState = makeAStarInitialState(buffers);
+        AStarSolver solver(buffers, MAX_NODES_PER_INSTANCE, false, 1);
+        AStarSolution solution = solver.solve(initialState);
+        std::cout.rdbuf(console);
+
+        if (!solution.found || solver.getAllSolutions().empty()) {
+            continue;
+        }
+        solved++;
+
+        // Remaining lateness along the optimal plan is the exact cost-to-go
+        LearnedHeuristic features(buffers);
+        const auto& path = solver.getAllSolutions().front().path;
+        double total = path.back().getTotalLateness();
+        for (const auto& state : path) {
+            samples.push_back(features.computeFeatures(state));
+            targets.push_back(total - state.getTotalLateness());
+        }
+    }
+    std::remove(instancePath.c_str());
+
+    if (samples.empty()) {
+        std::cerr << "No instance was solved, nothing to train on" << std::endl;
+        return 1;
+    }
+
+    // Ridge regression on features scaled to unit mean magnitude
+    std::vector<double> scale(N, 0.0);
+    for (const auto& x : samples) {
+        for (int i = 0; i < N; i++) {
+            scale[i] += std::abs(x[i]);
+        }
+    }
+    for (int i = 0; i < N; i++) {
+        scale[i] = scale[i] > 0 ? scale[i] / samples.size() : 1.0;
+    }
+
+    std::vector<std::vector<double>> a(N, std::vector<double>(N, 0.0));
+    std::vector<double> b(N, 0.0);
+    for (size_t s = 0; s < samples.size(); s++) {
+        for (int i = 0; i < N; i++) {
+            double xi = samples[s][i] / scale[i];
+            b[i] += xi * targets[s];
+            for (int j = 0; j < N; j++) {
+                a[i][j] += xi * samples[s][j] / scale[j];
+            }
+        }
+    }
+    for (int i = 0; i < N; i++) {
+        a[i][i] += RIDGE * samples.size();
+    }
+    std::vector<double> w = solveLinearSystem(a, b);
+    for (int i = 0; i < N; i++) {
+        w[i] /= scale[i];
+    }
+
+    double absoluteError = 0.0;
+    for (size_t s = 0; s < samples.size(); s++) {
+        double estimate = 0.0;
+        for (int i = 0; i < N; i++) {
+            estimate += w[i] * samples[s][i];
+        }
+        absoluteError += std::abs(std::max(0.0, estimate) - targets[s]);
+    }
+
+    std::ofstream header(output);
+    header << "#ifndef LEARNED_HEURISTIC_MODEL_H\n#define LEARNED_HEURISTIC_MODEL_H\n\n"
+           << "// Generated by trainLearnedHeuristic.cpp - do not edit by hand.\n"
+           << "// " << solved << " yards of " << containers << " containers (seed " << seed << "), "
+           << samples.size() << " states, mean absolute error "
+           << std::fixed << std::setprecision(1) << absoluteError / samples.size() << " s.\n"
+           << "namespace LearnedHeuristicModel {\n"
+           << "constexpr int FEATURE_COUNT = " << N << ";\n"
+           << "constexpr double WEIGHTS[FEATURE_COUNT] = {";
+    header << std::setprecision(9) << std::defaultfloat;
+    for (int i = 0; i < N; i++) {
+        header << (i ? ", " : "") << w[i];
+    }
+    header << "};\n}\n\n#endif\n";
+
+    std::cout << "Solved " << solved << "/" << instances << " yards, " << samples.size() << " states" << std::endl;
+    std::cout << "Mean absolute error: " << absoluteError / samples.size() << " s" << std::endl;
+    std::cout << "Model written to " << output << std::endl;
+    return 0;
+}